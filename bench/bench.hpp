@@ -0,0 +1,442 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <chain/chain.hpp>
+
+#include "alloc_tracker.hpp"
+
+namespace chain::bench
+{
+/**
+ * Keeps `value` and everything it points to observable so the compiler can't drop the
+ * computation that produced it.
+ */
+template<typename T>
+inline auto do_not_optimize(const T& value) -> void
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * The command line options shared by the benchmark executables.
+ */
+struct options
+{
+    /// The smallest input size in bytes.
+    std::size_t min_size{8};
+    /// The largest input size in bytes, sizes grow by 8x from `min_size` and always include this.
+    std::size_t max_size{64 * 1024 * 1024};
+    /// The number of timed repetitions, the reported value is their median.
+    std::size_t repetitions{9};
+    /// The minimum duration of each repetition, iterations are calibrated during warm-up to reach it.
+    double min_time_ms{10.0};
+    /// Only benchmarks whose name contains this run.
+    std::string filter{};
+    /// The JSON results are written here, or to stdout if empty.
+    std::string json{};
+    /// Run at this simd_level instead of the detected one.
+    std::optional<str::simd_level> level{};
+    /// The most threads the scaling benchmark runs, 0 uses every hardware thread.
+    std::size_t max_threads{0};
+    /// The scaling benchmark flags functions whose parallel efficiency falls below this.
+    double min_efficiency{0.8};
+
+    /**
+     * @return The options parsed from `argv`, or std::nullopt after printing the usage on an error.
+     */
+    static auto parse(int argc, char* argv[]) -> std::optional<options> { return parse(argc, argv, options{}); }
+
+    /**
+     * @param defaults The options before any command line arguments are applied.
+     * @return The options parsed from `argv`, or std::nullopt after printing the usage on an error.
+     */
+    static auto parse(int argc, char* argv[], options defaults) -> std::optional<options>
+    {
+        options opts{std::move(defaults)};
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg{argv[i]};
+            if (arg == "--help" || i + 1 == argc)
+            {
+                usage(argv[0]);
+                return std::nullopt;
+            }
+
+            std::string_view value{argv[++i]};
+            if (arg == "--min-size")
+            {
+                opts.min_size = str::to_number<std::size_t>(value).value_or(0);
+            }
+            else if (arg == "--max-size")
+            {
+                opts.max_size = str::to_number<std::size_t>(value).value_or(0);
+            }
+            else if (arg == "--repetitions")
+            {
+                opts.repetitions = str::to_number<std::size_t>(value).value_or(0);
+            }
+            else if (arg == "--min-time-ms")
+            {
+                opts.min_time_ms = str::to_number<double>(value).value_or(-1.0);
+            }
+            else if (arg == "--filter")
+            {
+                opts.filter = std::string{value};
+            }
+            else if (arg == "--json")
+            {
+                opts.json = std::string{value};
+            }
+            else if (arg == "--max-threads")
+            {
+                opts.max_threads = str::to_number<std::size_t>(value).value_or(0);
+            }
+            else if (arg == "--min-efficiency")
+            {
+                opts.min_efficiency = str::to_number<double>(value).value_or(-1.0);
+            }
+            else if (arg == "--simd-level")
+            {
+                opts.level = str::simd_level_from_string(value);
+                if (!opts.level.has_value())
+                {
+                    usage(argv[0]);
+                    return std::nullopt;
+                }
+            }
+            else
+            {
+                usage(argv[0]);
+                return std::nullopt;
+            }
+        }
+
+        if (opts.min_size == 0 || opts.max_size < opts.min_size || opts.repetitions == 0 || opts.min_time_ms < 0.0 ||
+            opts.min_efficiency < 0.0)
+        {
+            usage(argv[0]);
+            return std::nullopt;
+        }
+        return opts;
+    }
+
+    static auto usage(std::string_view name) -> void
+    {
+        // The names simd_level_from_string accepts.
+        std::string levels{};
+        for (auto level : {str::simd_level::scalar,
+                           str::simd_level::sse2,
+                           str::simd_level::sse42,
+                           str::simd_level::avx2,
+                           str::simd_level::avx512})
+        {
+            levels += levels.empty() ? "" : "|";
+            levels += str::to_string(level);
+        }
+
+        std::cerr << "usage: " << name << " [--min-size bytes] [--max-size bytes] [--repetitions n]\n"
+                  << "    [--min-time-ms ms] [--filter name] [--json path]\n"
+                  << "    [--simd-level " << levels << "] [--max-threads n] [--min-efficiency ratio]\n";
+    }
+
+    /**
+     * @return The input sizes from `min_size` to `max_size`, growing by 8x.
+     */
+    auto sizes() const -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> out{};
+        for (std::size_t size = min_size; size < max_size; size *= 8)
+        {
+            out.push_back(size);
+        }
+        out.push_back(max_size);
+        return out;
+    }
+};
+
+/**
+ * @return `value` as a JSON string literal.
+ */
+inline auto json_quote(std::string_view value) -> std::string
+{
+    std::string out{"\""};
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out.push_back('\\');
+        }
+        out.push_back(c);
+    }
+    out.push_back('"');
+    return out;
+}
+
+/**
+ * The measurements of one benchmark at one input size.
+ */
+struct result
+{
+    std::string name{};
+    /// "sensitive", "insensitive" or empty when the function has no `case_t` mode.
+    std::string case_name{};
+    std::size_t size{0};
+    /// The bytes each operation processes, used for the throughput.
+    std::size_t bytes{0};
+    std::size_t iterations{0};
+    /// Nanoseconds per operation of each repetition, sorted.
+    std::vector<double> samples{};
+    /// Heap allocations of one warmed up operation.
+    std::size_t allocations{0};
+
+    auto median() const -> double
+    {
+        const std::size_t n = samples.size();
+        return (n % 2 == 1) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+    }
+
+    /**
+     * @return The median absolute deviation relative to the median, a spread estimate that
+     *         ignores the odd repetition disturbed by the rest of the system.
+     */
+    auto relative_mad() const -> double
+    {
+        const double        mid = median();
+        std::vector<double> deviations{};
+        for (auto sample : samples)
+        {
+            deviations.push_back(std::abs(sample - mid));
+        }
+        std::sort(deviations.begin(), deviations.end());
+        const std::size_t n   = deviations.size();
+        const double      mad = (n % 2 == 1) ? deviations[n / 2] : (deviations[n / 2 - 1] + deviations[n / 2]) / 2.0;
+        return mid > 0.0 ? mad / mid : 0.0;
+    }
+
+    /// Bytes per nanosecond is GB/s.
+    auto gb_per_s() const -> double { return median() > 0.0 ? static_cast<double>(bytes) / median() : 0.0; }
+};
+
+/**
+ * Runs benchmarks with warm-up, calibrated iteration counts and repeated timing, then reports
+ * every result as a table on stderr and as JSON.
+ */
+class runner
+{
+public:
+    explicit runner(options opts) : m_options(std::move(opts)), m_results() {}
+
+    auto config() const -> const options& { return m_options; }
+
+    /**
+     * @param name The name of the benchmark.
+     * @return True if `name` passes the filter.
+     */
+    auto enabled(std::string_view name) const -> bool
+    {
+        return m_options.filter.empty() || name.find(m_options.filter) != std::string_view::npos;
+    }
+
+    /**
+     * Times `op`, it is called repeatedly and must do the same amount of work on every call.
+     * @param name The name of the benchmark.
+     * @param case_name The `case_t` mode, or empty.
+     * @param size The input size in bytes.
+     * @param bytes The bytes each call of `op` processes.
+     * @param op The operation to time.
+     */
+    template<typename functor_type>
+    auto run(std::string_view name, std::string_view case_name, std::size_t size, std::size_t bytes, functor_type&& op)
+        -> void
+    {
+        using clock = std::chrono::steady_clock;
+
+        if (!enabled(name))
+        {
+            return;
+        }
+
+        // Warm up the caches, the branch predictors and the CPU frequency for at least half a
+        // repetition, this also estimates the cost of one call.
+        const double warm_up_ns = m_options.min_time_ms * 1e6 / 2.0;
+        std::size_t  warm_ups{0};
+        const auto   start = clock::now();
+        double       elapsed{0.0};
+        do
+        {
+            op();
+            ++warm_ups;
+            elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        } while (elapsed < warm_up_ns);
+
+        const double per_op = elapsed / static_cast<double>(warm_ups);
+        const auto   target = m_options.min_time_ms * 1e6;
+
+        result r{};
+        r.name       = std::string{name};
+        r.case_name  = std::string{case_name};
+        r.size       = size;
+        r.bytes      = bytes;
+        r.iterations = std::max<std::size_t>(1, static_cast<std::size_t>(target / std::max(per_op, 1.0)));
+
+        for (std::size_t repetition = 0; repetition < m_options.repetitions; ++repetition)
+        {
+            const auto first = clock::now();
+            for (std::size_t i = 0; i < r.iterations; ++i)
+            {
+                op();
+            }
+            const auto last = clock::now();
+            r.samples.push_back(
+                std::chrono::duration<double, std::nano>(last - first).count() / static_cast<double>(r.iterations));
+        }
+        std::sort(r.samples.begin(), r.samples.end());
+        r.allocations = alloc_tracker::count(op).allocations;
+
+        std::cerr << std::left << std::setw(32) << r.name << std::setw(12) << r.case_name << std::right
+                  << std::setw(10) << r.size << std::fixed << std::setprecision(2) << std::setw(14) << r.median()
+                  << " ns/op" << std::setw(10) << r.gb_per_s() << " GB/s  +-" << std::setprecision(1)
+                  << r.relative_mad() * 100.0 << "%" << std::setw(8) << r.allocations << " allocs/op\n";
+
+        m_results.push_back(std::move(r));
+    }
+
+    auto results() const -> const std::vector<result>& { return m_results; }
+
+    /**
+     * Writes every result to `out` as JSON.
+     * @param suite The name of the benchmark executable.
+     */
+    auto write_json(std::ostream& out, std::string_view suite) const -> void
+    {
+        out << "{\n  \"context\": {\n"
+            << "    \"suite\": " << json_quote(suite) << ",\n"
+            << "    \"simd_level\": " << json_quote(str::to_string(str::active_simd_level())) << ",\n"
+#if defined(CHAIN_BENCH_BUILD_TYPE)
+            << "    \"build_type\": " << json_quote(CHAIN_BENCH_BUILD_TYPE) << ",\n"
+#endif
+            << "    \"repetitions\": " << m_options.repetitions << ",\n"
+            << "    \"min_time_ms\": " << m_options.min_time_ms << "\n  },\n  \"benchmarks\": [";
+
+        for (std::size_t i = 0; i < m_results.size(); ++i)
+        {
+            const auto& r = m_results[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"name\": " << json_quote(r.name)
+                << ", \"case\": " << (r.case_name.empty() ? std::string{"null"} : json_quote(r.case_name))
+                << ", \"size\": " << r.size << ", \"bytes_per_op\": " << r.bytes << ", \"iterations\": " << r.iterations
+                << ", \"repetitions\": " << r.samples.size() << std::setprecision(6) << std::defaultfloat
+                << ", \"ns_per_op\": " << r.median() << ", \"ns_per_op_min\": " << r.samples.front()
+                << ", \"ns_per_op_max\": " << r.samples.back() << ", \"relative_mad\": " << r.relative_mad()
+                << ", \"gb_per_s\": " << r.gb_per_s() << ", \"allocations_per_op\": " << r.allocations << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+private:
+    options             m_options;
+    std::vector<result> m_results;
+};
+
+/**
+ * Deterministic mixed case text of short words separated by spaces with a comma every few words,
+ * it never contains a 'z' so absent needles can use one.
+ * @param size The size of the text in bytes.
+ */
+inline auto make_text(std::size_t size) -> std::string
+{
+    static constexpr std::string_view words[] = {
+        "Lorem", "ipsum", "DOLOR", "sit", "amet", "Consectetur", "adipiscing", "elit", "sed", "do", "Eiusmod",
+        "tempor"};
+
+    std::string out{};
+    out.reserve(size + 16);
+    uint64_t state{0x9E3779B97F4A7C15ULL};
+    while (out.size() < size)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        out.append(words[state % std::size(words)]);
+        out.push_back((state >> 32) % 6 == 0 ? ',' : ' ');
+    }
+    out.resize(size);
+    return out;
+}
+
+/**
+ * Deterministic comma separated decimal integers of 1 to 19 digits, some of them negative.
+ * @param size The size of the text in bytes.
+ */
+inline auto make_numbers(std::size_t size) -> std::string
+{
+    std::string out{};
+    out.reserve(size + 32);
+    uint64_t state{0x2545F4914F6CDD1DULL};
+    while (out.size() < size)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        if (state % 4 == 0)
+        {
+            out.push_back('-');
+        }
+        out.append(std::to_string((state >> 1) % 1000000000000000000ULL).substr(0, 1 + (state >> 40) % 19));
+        out.push_back(',');
+    }
+    out.resize(size);
+    return out;
+}
+
+/**
+ * Runs `suite` with the parsed command line and writes its JSON results.
+ * @return The process exit code.
+ */
+template<typename functor_type>
+auto main(int argc, char* argv[], std::string_view suite, functor_type&& benchmarks) -> int
+{
+    auto opts = options::parse(argc, argv);
+    if (!opts.has_value())
+    {
+        return EXIT_FAILURE;
+    }
+    if (opts->level.has_value())
+    {
+        str::force_simd_level(opts->level.value());
+    }
+
+    runner r{std::move(opts.value())};
+    benchmarks(r);
+
+    if (r.config().json.empty())
+    {
+        r.write_json(std::cout, suite);
+    }
+    else
+    {
+        std::ofstream out{r.config().json};
+        r.write_json(out, suite);
+        if (!out)
+        {
+            std::cerr << "failed to write " << r.config().json << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace chain::bench
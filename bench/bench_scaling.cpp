@@ -0,0 +1,322 @@
+#include "bench.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+// Runs each function on 1 to `--max-threads` threads at once, every thread pinned to its own CPU
+// and working on its own copy of the input, and reports the aggregate ops/s.  Throughput that
+// doesn't grow with the thread count points at shared state, e.g. a lock, a shared cache line or
+// a global the function touches.  Each thread works on `--max-size` bytes per op, each thread
+// count runs for `--min-time-ms` and the median of `--repetitions` runs is reported.
+
+using namespace chain;
+
+/**
+ * The private data of one benchmark thread.  Aligned and padded to whole cache lines so the
+ * threads' states never share one.
+ */
+struct alignas(64) thread_state
+{
+    std::string                   text{};
+    std::string                   numbers{};
+    std::string                   scratch{};
+    std::vector<std::string_view> parts{};
+    std::vector<int64_t>          values{};
+};
+
+struct workload
+{
+    std::string_view name;
+    /// Runs one operation and returns a value that depends on its result.
+    auto (*op)(thread_state& state) -> std::size_t;
+};
+
+static const workload workloads[] = {
+    {"replace(sensitive)",
+     [](thread_state& state) -> std::size_t {
+         state.scratch.assign(state.text);
+         return str::replace<str::case_t::sensitive>(state.scratch, "ipsum", "ferp");
+     }},
+    {"replace(insensitive)",
+     [](thread_state& state) -> std::size_t {
+         state.scratch.assign(state.text);
+         return str::replace<str::case_t::insensitive>(state.scratch, "IPSUM", "ferp");
+     }},
+    {"find(insensitive)",
+     [](thread_state& state) -> std::size_t { return str::find<str::case_t::insensitive>(state.text, "ZEBRA"); }},
+    {"split(char)",
+     [](thread_state& state) -> std::size_t {
+         state.parts.clear();
+         str::split(state.text, ',', state.parts);
+         return state.parts.size();
+     }},
+    {"join(strings)", [](thread_state& state) -> std::size_t { return str::join(state.parts, ',').size(); }},
+    {"join(integers)", [](thread_state& state) -> std::size_t { return str::join(state.values, ',').size(); }},
+    {"to_lower_copy", [](thread_state& state) -> std::size_t { return str::to_lower_copy(state.text).size(); }},
+    {"trim_view",
+     [](thread_state& state) -> std::size_t { return str::trim_view(std::string_view{state.text}).size(); }},
+    {"to_number<int64_t>",
+     [](thread_state& state) -> std::size_t {
+         std::size_t sum{0};
+         str::split_for_each(state.numbers, ',', [&](std::string_view field) {
+             sum += static_cast<std::size_t>(str::to_number<int64_t>(field).value_or(0));
+         });
+         return sum;
+     }},
+    {"to_number<double>",
+     [](thread_state& state) -> std::size_t {
+         double sum{0.0};
+         str::split_for_each(state.numbers, ',', [&](std::string_view field) {
+             sum += str::to_number<double>(field).value_or(0.0);
+         });
+         return static_cast<std::size_t>(sum);
+     }},
+    {"strerror", [](thread_state&) -> std::size_t { return str::strerror(EAGAIN).size(); }},
+    {"strerror_view", [](thread_state&) -> std::size_t { return str::strerror_view(EAGAIN).size(); }},
+};
+
+/**
+ * @return The CPUs this process may run on, in order.
+ */
+static auto allowed_cpus() -> std::vector<int>
+{
+    std::vector<int> cpus{};
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &set))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty())
+    {
+        cpus.push_back(-1);
+    }
+    return cpus;
+}
+
+/**
+ * Pins the calling thread to `cpu`, a negative `cpu` or a platform without affinity leaves it unpinned.
+ */
+static auto pin_to(int cpu) -> void
+{
+#if defined(__linux__)
+    if (cpu >= 0)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+/**
+ * Runs `work` on `threads` threads for `duration_ms`.
+ * @return The operations completed by every thread per second of the run.
+ */
+static auto measure(const workload& work, std::size_t threads, double duration_ms, const std::vector<int>& cpus,
+                    std::vector<thread_state>& states) -> double
+{
+    std::atomic<std::size_t> ready{0};
+    std::atomic<bool>        go{false};
+    std::atomic<bool>        stop{false};
+    std::vector<std::size_t> ops(threads, 0);
+    std::vector<std::thread> workers{};
+
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]() {
+            pin_to(cpus[t % cpus.size()]);
+            auto& state = states[t];
+
+            // Warm up this thread's copy of the input and any lazily built tables.
+            bench::do_not_optimize(work.op(state));
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            std::size_t count{0};
+            std::size_t sink{0};
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                sink += work.op(state);
+                ++count;
+            }
+            bench::do_not_optimize(sink);
+            ops[t] = count;
+        });
+    }
+
+    while (ready.load() < threads)
+    {
+        std::this_thread::yield();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(duration_ms));
+    stop.store(true, std::memory_order_relaxed);
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    // Up to the join, each thread may finish the operation it was in when `stop` was set.
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t total{0};
+    for (auto count : ops)
+    {
+        total += count;
+    }
+    return static_cast<double>(total) / elapsed;
+}
+
+/**
+ * The scaling of one workload at one thread count.
+ */
+struct point
+{
+    std::size_t threads{0};
+    double      ops_per_s{0.0};
+    /// `ops_per_s` over the single thread rate times the threads that can run in parallel.
+    double efficiency{0.0};
+};
+
+int main(int argc, char* argv[])
+{
+    bench::options defaults{};
+    defaults.max_size    = 4096;
+    defaults.min_time_ms = 200.0;
+    defaults.repetitions = 3;
+
+    auto opts = bench::options::parse(argc, argv, defaults);
+    if (!opts.has_value())
+    {
+        return EXIT_FAILURE;
+    }
+    if (opts->level.has_value())
+    {
+        str::force_simd_level(opts->level.value());
+    }
+
+    const auto        cpus = allowed_cpus();
+    const std::size_t max_threads =
+        opts->max_threads > 0 ? opts->max_threads : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+    // Powers of two up to and always including the maximum.
+    std::vector<std::size_t> thread_counts{};
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2)
+    {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    std::vector<thread_state> states(max_threads);
+    for (auto& state : states)
+    {
+        state.text    = bench::make_text(opts->max_size);
+        state.numbers = bench::make_numbers(opts->max_size);
+        state.parts   = str::split(state.text, ',');
+        str::split_for_each(state.numbers, ',', [&](std::string_view field) {
+            state.values.push_back(str::to_number<int64_t>(field).value_or(0));
+        });
+    }
+
+    std::ostringstream json{};
+    json << "{\n  \"context\": {\n"
+         << "    \"suite\": \"scaling\",\n"
+         << "    \"simd_level\": " << bench::json_quote(str::to_string(str::active_simd_level())) << ",\n"
+#if defined(CHAIN_BENCH_BUILD_TYPE)
+         << "    \"build_type\": " << bench::json_quote(CHAIN_BENCH_BUILD_TYPE) << ",\n"
+#endif
+         << "    \"cpus\": " << cpus.size() << ",\n"
+         << "    \"size\": " << opts->max_size << ",\n"
+         << "    \"repetitions\": " << opts->repetitions << ",\n"
+         << "    \"min_time_ms\": " << opts->min_time_ms << ",\n"
+         << "    \"min_efficiency\": " << opts->min_efficiency << "\n  },\n  \"benchmarks\": [";
+
+    bool first_workload{true};
+    for (const auto& work : workloads)
+    {
+        if (!opts->filter.empty() && work.name.find(opts->filter) == std::string_view::npos)
+        {
+            continue;
+        }
+
+        std::vector<point> points{};
+        bool               scales{true};
+        for (auto threads : thread_counts)
+        {
+            std::vector<double> samples{};
+            for (std::size_t repetition = 0; repetition < opts->repetitions; ++repetition)
+            {
+                samples.push_back(measure(work, threads, opts->min_time_ms, cpus, states));
+            }
+            std::sort(samples.begin(), samples.end());
+
+            point p{};
+            p.threads   = threads;
+            p.ops_per_s = samples[samples.size() / 2];
+
+            const auto parallel = static_cast<double>(std::min(threads, cpus.size()));
+            p.efficiency = points.empty() ? 1.0 : p.ops_per_s / (points.front().ops_per_s * parallel);
+            scales       = scales && p.efficiency >= opts->min_efficiency;
+            points.push_back(p);
+
+            std::cerr << std::left << std::setw(24) << work.name << std::right << std::setw(4) << threads
+                      << " threads" << std::fixed << std::setprecision(0) << std::setw(16) << p.ops_per_s << " ops/s"
+                      << std::setprecision(2) << std::setw(8) << p.efficiency
+                      << (p.efficiency < opts->min_efficiency ? "  DOES NOT SCALE\n" : "\n");
+        }
+
+        json << (first_workload ? "\n" : ",\n") << "    {\"name\": " << bench::json_quote(work.name)
+             << ", \"scales\": " << (scales ? "true" : "false") << ", \"points\": [";
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            json << (i == 0 ? "" : ", ") << "{\"threads\": " << points[i].threads
+                 << ", \"ops_per_s\": " << points[i].ops_per_s << ", \"efficiency\": " << points[i].efficiency << "}";
+        }
+        json << "]}";
+        first_workload = false;
+    }
+    json << "\n  ]\n}\n";
+
+    if (opts->json.empty())
+    {
+        std::cout << json.str();
+    }
+    else
+    {
+        std::ofstream out{opts->json};
+        out << json.str();
+        if (!out)
+        {
+            std::cerr << "failed to write " << opts->json << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,369 @@
+#include "bench.hpp"
+
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Throughput of every chain::str function across input sizes, in both `case_t` modes where the
+// function has them.  See `options::usage()` for the command line, the results are JSON.
+
+using namespace chain;
+
+template<str::case_t case_type>
+static constexpr auto case_name() -> std::string_view
+{
+    return case_type == str::case_t::sensitive ? "sensitive" : "insensitive";
+}
+
+/**
+ * @return The needle in the case the text uses for sensitive searches and upper case otherwise,
+ *         so the insensitive searches have to fold to match.
+ */
+template<str::case_t case_type>
+static auto needle(std::string_view value) -> std::string
+{
+    return case_type == str::case_t::sensitive ? std::string{value} : str::to_upper_copy(value);
+}
+
+template<str::case_t case_type>
+static auto bench_search(bench::runner& r, const std::string& text) -> void
+{
+    constexpr auto mode = case_name<case_type>();
+    const auto     size = text.size();
+
+    // 'z' never appears in the text, absent needles scan all of it.
+    const auto absent  = needle<case_type>("zebra");
+    const auto present = needle<case_type>("ipsum");
+    const auto copy    = (case_type == str::case_t::sensitive) ? text : str::to_upper_copy(text);
+
+    r.run("find", mode, size, size, [&]() { bench::do_not_optimize(str::find<case_type>(text, absent)); });
+    r.run("rfind", mode, size, size, [&]() { bench::do_not_optimize(str::rfind<case_type>(text, absent)); });
+    r.run("count", mode, size, size, [&]() { bench::do_not_optimize(str::count<case_type>(text, present)); });
+
+    std::vector<std::size_t> positions{};
+    r.run("find_all", mode, size, size, [&]() {
+        positions.clear();
+        str::find_all<case_type>(text, present, positions);
+        bench::do_not_optimize(positions.data());
+    });
+
+    const str::searcher<case_type> compiled{absent};
+    r.run("searcher::find", mode, size, size, [&]() { bench::do_not_optimize(compiled.find(text)); });
+    r.run("searcher::rfind", mode, size, size, [&]() { bench::do_not_optimize(compiled.rfind(text)); });
+
+    const auto                           dolor = needle<case_type>("dolor");
+    const str::multi_searcher<case_type> many{{present, dolor, absent}};
+    std::vector<typename str::multi_searcher<case_type>::match> matches{};
+    r.run("multi_searcher::find_all", mode, size, size, [&]() {
+        matches.clear();
+        many.find_all(text, matches);
+        bench::do_not_optimize(matches.data());
+    });
+
+    r.run("equal", mode, size, size, [&]() { bench::do_not_optimize(str::equal<case_type>(text, copy)); });
+    r.run("starts_with", mode, size, size, [&]() { bench::do_not_optimize(str::starts_with<case_type>(text, copy)); });
+    r.run("ends_with", mode, size, size, [&]() { bench::do_not_optimize(str::ends_with<case_type>(text, copy)); });
+}
+
+template<str::case_t case_type>
+static auto bench_split(bench::runner& r, const std::string& text) -> void
+{
+    constexpr auto mode  = case_name<case_type>();
+    const auto     size  = text.size();
+    const auto     delim = needle<case_type>("ipsum");
+
+    std::vector<std::string_view> parts{};
+    r.run("split(string_view)", mode, size, size, [&]() {
+        parts.clear();
+        str::split<case_type>(text, delim, parts);
+        bench::do_not_optimize(parts.data());
+    });
+
+    const str::searcher<case_type> compiled{delim};
+    r.run("split(searcher)", mode, size, size, [&]() {
+        parts.clear();
+        str::split(text, compiled, parts);
+        bench::do_not_optimize(parts.data());
+    });
+
+    r.run("split_for_each(string_view)", mode, size, size, [&]() {
+        std::size_t n{0};
+        str::split_for_each<case_type>(text, delim, [&](std::string_view) { ++n; });
+        bench::do_not_optimize(n);
+    });
+
+    r.run("split_view", mode, size, size, [&]() {
+        std::size_t n{0};
+        for (auto part : str::split_view<case_type>{text, delim})
+        {
+            n += part.size();
+        }
+        bench::do_not_optimize(n);
+    });
+}
+
+static auto bench_split_char(bench::runner& r, const std::string& text) -> void
+{
+    const auto size = text.size();
+
+    std::vector<std::string_view> parts{};
+    r.run("split(char)", "", size, size, [&]() {
+        parts.clear();
+        str::split(text, ',', parts);
+        bench::do_not_optimize(parts.data());
+    });
+
+    r.run("split_for_each(char)", "", size, size, [&]() {
+        std::size_t n{0};
+        str::split_for_each(text, ',', [&](std::string_view) { ++n; });
+        bench::do_not_optimize(n);
+    });
+
+    std::vector<std::size_t> sizes{};
+    r.run("split_map(char)", "", size, size, [&]() {
+        sizes.clear();
+        str::split_map<std::size_t>(text, ',', [](std::string_view part) { return part.size(); }, sizes);
+        bench::do_not_optimize(sizes.data());
+    });
+}
+
+static auto bench_join(bench::runner& r, const std::string& text) -> void
+{
+    const auto size  = text.size();
+    const auto parts = str::split(text, ' ');
+
+    r.run("join", "", size, size, [&]() { bench::do_not_optimize(str::join(parts, ' ').size()); });
+
+    std::string out{};
+    r.run("join_into(string)", "", size, size, [&]() {
+        out.clear();
+        str::join_into(out, parts, ' ');
+        bench::do_not_optimize(out.data());
+    });
+
+    std::vector<char> buffer(size);
+    r.run("join_into(char*)", "", size, size, [&]() {
+        bench::do_not_optimize(str::join_into(buffer.data(), buffer.size(), parts, ' '));
+    });
+
+    r.run("map_join", "", size, size, [&]() {
+        bench::do_not_optimize(str::map_join(parts, ',', [](std::string_view part) { return part.size(); }).size());
+    });
+}
+
+template<str::case_t case_type>
+static auto bench_trim(bench::runner& r, std::size_t size) -> void
+{
+    constexpr auto mode = case_name<case_type>();
+
+    // Repeats of the value to remove with a single other byte in the middle, each side scans half.
+    std::string data{};
+    while (data.size() < size)
+    {
+        data.append("ab");
+    }
+    data.resize(size);
+    data[size / 2] = 'x';
+
+    const auto to_remove = needle<case_type>("ab");
+    r.run("trim_view(string_view)", mode, size, size, [&]() {
+        bench::do_not_optimize(str::trim_view<case_type>(data, to_remove).size());
+    });
+    r.run("trim_left_view(string_view)", mode, size, size / 2, [&]() {
+        bench::do_not_optimize(str::trim_left_view<case_type>(data, to_remove).size());
+    });
+    r.run("trim_right_view(string_view)", mode, size, size / 2, [&]() {
+        bench::do_not_optimize(str::trim_right_view<case_type>(data, to_remove).size());
+    });
+}
+
+static auto bench_trim_space(bench::runner& r, std::size_t size) -> void
+{
+    std::string data{};
+    while (data.size() < size)
+    {
+        data.append(" \t\r\n");
+    }
+    data.resize(size);
+    data[size / 2] = 'x';
+
+    r.run("trim_view", "", size, size, [&]() { bench::do_not_optimize(str::trim_view(data).size()); });
+    r.run("trim_left_view", "", size, size / 2, [&]() { bench::do_not_optimize(str::trim_left_view(data).size()); });
+    r.run("trim_right_view", "", size, size / 2, [&]() {
+        bench::do_not_optimize(str::trim_right_view(data).size());
+    });
+
+    // The in place versions copy the input back first, that copy is included.
+    std::string copy{};
+    copy.reserve(size);
+    r.run("trim", "", size, size, [&]() {
+        copy.assign(data);
+        str::trim(copy);
+        bench::do_not_optimize(copy.data());
+    });
+}
+
+static auto bench_case(bench::runner& r, const std::string& text) -> void
+{
+    const auto size = text.size();
+
+    std::string data{text};
+    r.run("to_lower", "", size, size, [&]() {
+        str::to_lower(data);
+        bench::do_not_optimize(data.data());
+    });
+    r.run("to_upper", "", size, size, [&]() {
+        str::to_upper(data);
+        bench::do_not_optimize(data.data());
+    });
+    r.run("to_lower_copy", "", size, size, [&]() { bench::do_not_optimize(str::to_lower_copy(text).size()); });
+    r.run("to_upper_copy", "", size, size, [&]() { bench::do_not_optimize(str::to_upper_copy(text).size()); });
+
+    std::vector<char> out(size);
+    r.run("to_lower_ascii", "", size, size, [&]() {
+        str::to_lower_ascii(text, out.data());
+        bench::do_not_optimize(out.data());
+    });
+    r.run("to_upper_ascii", "", size, size, [&]() {
+        str::to_upper_ascii(text, out.data());
+        bench::do_not_optimize(out.data());
+    });
+}
+
+template<str::case_t case_type>
+static auto bench_replace(bench::runner& r, const std::string& text) -> void
+{
+    constexpr auto mode = case_name<case_type>();
+    const auto     size = text.size();
+
+    // Same length replacements swapped back and forth so every call does the same work in place.
+    std::string data{text};
+    const auto  from = needle<case_type>("ipsum");
+    const auto  back = needle<case_type>("ipsux");
+    bool        flip{false};
+    r.run("replace(same length)", mode, size, size, [&]() {
+        flip = !flip;
+        bench::do_not_optimize(str::replace<case_type>(data, flip ? from : back, flip ? "ipsux" : "ipsum"));
+    });
+
+    r.run("replace_copy(longer)", mode, size, size, [&]() {
+        bench::do_not_optimize(str::replace_copy<case_type>(text, from, "ipsum dolor").first.size());
+    });
+
+    const auto dolor  = needle<case_type>("dolor");
+    const auto tempor = needle<case_type>("tempor");
+    const std::vector<std::pair<std::string_view, std::string_view>> table{{from, "a"}, {dolor, "bb"}, {tempor, "ccc"}};
+    r.run("replace_all_copy", mode, size, size, [&]() {
+        bench::do_not_optimize(str::replace_all_copy<case_type>(text, table).first.size());
+    });
+
+    std::size_t written{0};
+    r.run("stream_replacer(4 KiB chunks)", mode, size, size, [&]() {
+        str::stream_replacer<case_type> replacer{from, "ipsum dolor"};
+        auto                            sink = [&](std::string_view out) { written += out.size(); };
+        for (std::size_t offset = 0; offset < size; offset += 4096)
+        {
+            replacer.write(std::string_view{text}.substr(offset, 4096), sink);
+        }
+        replacer.finish(sink);
+        bench::do_not_optimize(written);
+    });
+}
+
+static auto bench_pipeline(bench::runner& r, const std::string& text) -> void
+{
+    const auto size = text.size();
+
+    // The same steps as one pass each and as a single fused pass.
+    r.run("trim+to_lower+replace+split(separate)", "", size, size, [&]() {
+        auto data = str::to_lower_copy(str::trim_view(text));
+        str::replace(data, "ipsum", "ferp");
+        bench::do_not_optimize(str::split(data, ',').size());
+    });
+
+    auto pipeline = str::chain(text).trim().lower().replace("ipsum", "ferp");
+    r.run("trim+to_lower+replace+split(chain)", "", size, size, [&]() {
+        std::size_t n{0};
+        pipeline.split_for_each(',', [&](std::string_view) { ++n; });
+        bench::do_not_optimize(n);
+    });
+}
+
+static auto bench_numbers(bench::runner& r, std::size_t size) -> void
+{
+    const auto numbers = bench::make_numbers(size);
+    const auto fields  = str::split(numbers, ',');
+
+    r.run("to_number<int64_t>", "", size, size, [&]() {
+        int64_t sum{0};
+        for (auto field : fields)
+        {
+            sum += str::to_number<int64_t>(field).value_or(0);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    std::vector<std::optional<int64_t>> values{};
+    r.run("to_numbers<int64_t>", "", size, size, [&]() {
+        values.clear();
+        bench::do_not_optimize(str::to_numbers<int64_t>(fields, values));
+    });
+
+    r.run("to_number<double>", "", size, size, [&]() {
+        double sum{0.0};
+        for (auto field : fields)
+        {
+            sum += str::to_number<double>(field).value_or(0.0);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    r.run("classify_number", "", size, size, [&]() {
+        std::size_t length{0};
+        for (auto field : fields)
+        {
+            length += str::classify_number(field).length;
+        }
+        bench::do_not_optimize(length);
+    });
+
+    r.run("is_number", "", size, size, [&]() {
+        std::size_t n{0};
+        for (auto field : fields)
+        {
+            n += str::is_number(field) ? 1 : 0;
+        }
+        bench::do_not_optimize(n);
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    return bench::main(argc, argv, "throughput", [](bench::runner& r) {
+        for (auto size : r.config().sizes())
+        {
+            const auto text = bench::make_text(size);
+
+            bench_search<str::case_t::sensitive>(r, text);
+            bench_search<str::case_t::insensitive>(r, text);
+            bench_split<str::case_t::sensitive>(r, text);
+            bench_split<str::case_t::insensitive>(r, text);
+            bench_split_char(r, text);
+            bench_join(r, text);
+            bench_trim<str::case_t::sensitive>(r, size);
+            bench_trim<str::case_t::insensitive>(r, size);
+            bench_trim_space(r, size);
+            bench_case(r, text);
+            bench_replace<str::case_t::sensitive>(r, text);
+            bench_replace<str::case_t::insensitive>(r, text);
+            bench_pipeline(r, text);
+            bench_numbers(r, size);
+        }
+
+        // Not proportional to an input size.
+        r.run("strerror_view", "", 0, 0, []() { bench::do_not_optimize(str::strerror_view(EAGAIN).size()); });
+        r.run("strerror", "", 0, 0, []() { bench::do_not_optimize(str::strerror(EAGAIN).size()); });
+    });
+}
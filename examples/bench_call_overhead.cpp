@@ -0,0 +1,63 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <chain/chain.hpp>
+
+// Times the out of line functions on short strings where the call overhead dominates, build this
+// against the `chain` and `chain_header_only` targets to compare the static library with inlining.
+
+template<typename functor_type>
+static auto bench(std::string_view name, std::size_t iterations, functor_type&& functor) -> void
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::size_t sink{0};
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        sink += functor(i);
+    }
+
+    auto end     = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    std::cout << name << ": " << static_cast<double>(elapsed.count()) / static_cast<double>(iterations)
+              << "ns/call (" << sink << ")\n";
+}
+
+int main()
+{
+    using namespace chain;
+
+    static constexpr size_t ITERATIONS = 20'000'000;
+
+#if defined(CHAIN_HEADER_ONLY)
+    std::cout << "header only, simd_level " << str::to_string(str::active_simd_level()) << "\n";
+#else
+    std::cout << "static library, simd_level " << str::to_string(str::active_simd_level()) << "\n";
+#endif
+
+    const std::vector<std::string> inputs{" derp ", "12345", "Herp", "\tx\n", "-42", "3.14", "MiXeD", "  "};
+
+    bench("trim_view", ITERATIONS, [&](std::size_t i) { return str::trim_view(inputs[i % inputs.size()]).size(); });
+    bench("trim_left_view", ITERATIONS, [&](std::size_t i) {
+        return str::trim_left_view(inputs[i % inputs.size()]).size();
+    });
+    bench("trim_right_view", ITERATIONS, [&](std::size_t i) {
+        return str::trim_right_view(inputs[i % inputs.size()]).size();
+    });
+    bench("is_int", ITERATIONS, [&](std::size_t i) {
+        return static_cast<std::size_t>(str::is_int(inputs[i % inputs.size()]));
+    });
+
+    std::string buffer{};
+    bench("to_lower", ITERATIONS, [&](std::size_t i) {
+        buffer = inputs[i % inputs.size()];
+        str::to_lower(buffer);
+        return static_cast<std::size_t>(buffer.front());
+    });
+    bench("strerror", ITERATIONS / 10, [&](std::size_t i) { return str::strerror(static_cast<int>(i % 32)).size(); });
+
+    return 0;
+}
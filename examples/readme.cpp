@@ -58,5 +58,16 @@ int main()
     // value == 420
     std::cout << value << "\n";
 
+    // Sanitizing many payloads with the same replacements, compile the needles once and reuse
+    // them.  replace_all with {from, to} pairs builds a new multi_searcher on every call.
+    const str::multi_searcher<str::case_t::sensitive> html{{"&", "<", ">"}};
+    const std::vector<std::string_view>               escaped{"&amp;", "&lt;", "&gt;"};
+    for (std::string payload : {"a < b", "Tom & Jerry"})
+    {
+        str::replace_all(payload, html, escaped);
+        // "a &lt; b", "Tom &amp; Jerry"
+        std::cout << payload << "\n";
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -1,15 +1,85 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
 #include <limits>
 #include <numeric>
 #include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+// Floating point std::from_chars and std::to_chars, older standard libraries only provide the integer overloads.
+#if !defined(CHAIN_FLOAT_CHARCONV)
+    #if defined(__cpp_lib_to_chars)
+        #define CHAIN_FLOAT_CHARCONV 1
+    #else
+        #define CHAIN_FLOAT_CHARCONV 0
+    #endif
+#endif
+
+// The SWAR number parsing reads words with the first character in the lowest byte.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    #define CHAIN_LITTLE_ENDIAN 1
+#elif defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+    #define CHAIN_LITTLE_ENDIAN 1
+#else
+    #define CHAIN_LITTLE_ENDIAN 0
+#endif
+
+#if !CHAIN_FLOAT_CHARCONV
+    #include <cerrno>
+    #include <cstdlib>
+#endif
+
+// The constexpr functions evaluate at compile time with a portable scalar path and use the SIMD
+// kernels at run time, telling them apart needs std::is_constant_evaluated() or its builtin.
+#if !defined(CHAIN_CONSTANT_EVALUATED)
+    #if defined(__cpp_lib_is_constant_evaluated)
+        #define CHAIN_CONSTANT_EVALUATED() std::is_constant_evaluated()
+    #elif defined(__has_builtin)
+        #if __has_builtin(__builtin_is_constant_evaluated)
+            #define CHAIN_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+        #endif
+    #elif defined(_MSC_VER) && _MSC_VER >= 1925
+        #define CHAIN_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+    #endif
+#endif
+#if !defined(CHAIN_CONSTANT_EVALUATED)
+    // The functions still work at run time but can't be evaluated at compile time.
+    #define CHAIN_CONSTANT_EVALUATED() false
+#endif
+
+// Defining CHAIN_HEADER_ONLY includes the implementation at the end of this header with every
+// function inline instead of linking the `chain` static library.
+#if defined(CHAIN_HEADER_ONLY)
+    #define CHAIN_INLINE inline
+#else
+    #define CHAIN_INLINE
+#endif
+
+// Defining CHAIN_INSTRUMENT=1 records per function call counts, bytes and latency histograms,
+// see `instrument::global_snapshot()`.  It must be the same for the library and its users, when
+// it is 0 (the default) the recording compiles to nothing.
+#if !defined(CHAIN_INSTRUMENT)
+    #define CHAIN_INSTRUMENT 0
+#endif
+
+#if CHAIN_INSTRUMENT
+    #include <atomic>
+    #include <chrono>
+#endif
+
 namespace chain::str
 {
 /// string stream with default formatting.
@@ -28,893 +98,3474 @@ enum class case_t
     insensitive
 };
 
+enum class overlap_t
+{
+    /**
+     * Matches can't share bytes, the search resumes after each match.  This is the default.
+     */
+    non_overlapping,
+
+    /**
+     * Every match is reported, the search resumes one byte after each match start.
+     */
+    overlapping
+};
+
 /**
- * Comapres two unsigned characeters for equality.
- * @tparam case_type Is the comparison case sensitive or insensitive?
- * @param left Left unsigned char to compare.
- * @param right Right unsigned char to compare.
- * @return True if left is the same as right with case sensitivity.
+ * The instruction set levels the accelerated kernels are compiled for.  The best level the CPU
+ * supports is detected once at runtime, it can be lowered with the CHAIN_SIMD_LEVEL environment
+ * variable (e.g. CHAIN_SIMD_LEVEL=sse2) or `force_simd_level()` for benchmarking and testing.
  */
-template<case_t case_type = case_t::sensitive>
-inline auto equal_uchar(unsigned char left, unsigned char right) -> bool
+enum class simd_level
 {
-    if constexpr (case_type == case_t::sensitive)
-    {
-        return left == right;
-    }
-    else
-    {
-        return std::tolower(left) == std::tolower(right);
-    }
-}
+    /// Portable byte at a time code, always available.
+    scalar,
+    sse2,
+    sse42,
+    avx2,
+    /// AVX-512F and AVX-512BW.
+    avx512
+};
 
 /**
- * Compares two string views with the given sensitivity for equality.
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param left Left string view to compare.
- * @param right Right string view to compare.
- * @return True if left is the same as right.
+ * @return The best level the running CPU supports.
  */
-template<case_t case_type = case_t::sensitive>
-auto equal(std::string_view left, std::string_view right) -> bool
+auto detected_simd_level() -> simd_level;
+
+/**
+ * @return The level the accelerated functions are currently using.
+ */
+auto active_simd_level() -> simd_level;
+
+/**
+ * Switches every accelerated function to `level`.  This is not intended to be called while other
+ * threads are using the library, in flight calls finish with the level they started with.
+ * @param level The level to use, it is lowered to `detected_simd_level()` if the CPU lacks it.
+ * @return The level now active.
+ */
+auto force_simd_level(simd_level level) -> simd_level;
+
+/**
+ * @param name The case insensitive name of a level as returned by `to_string()`.
+ * @return The level for `name` if it is valid.
+ */
+auto simd_level_from_string(std::string_view name) -> std::optional<simd_level>;
+
+/**
+ * @param level The level to get the name of.
+ * @return The name of `level`, "scalar", "sse2", "sse4.2", "avx2" or "avx512".
+ */
+auto to_string(simd_level level) -> std::string_view;
+
+namespace instrument
+{
+/// True when the library is built with CHAIN_INSTRUMENT.
+inline constexpr bool enabled = CHAIN_INSTRUMENT != 0;
+
+/**
+ * The functions that are recorded.  A call is recorded once by the function the caller used, e.g.
+ * `replace` doesn't also record the `find` calls it makes internally, overloads share an entry.
+ * Calls made from a `split_for_each` functor are part of that `split` call and a `to_numbers` batch
+ * is one `to_number` call.
+ */
+enum class function : std::size_t
+{
+    find,
+    rfind,
+    split,
+    join,
+    trim,
+    to_lower,
+    to_upper,
+    replace,
+    replace_all,
+    to_number,
+    classify_number,
+    strerror,
+    /// The number of functions, not a function.
+    count
+};
+
+inline constexpr std::size_t function_count = static_cast<std::size_t>(function::count);
+
+/// Latency bucket `i > 0` counts calls that took [2^(i-1), 2^i) nanoseconds, bucket 0 counts calls
+/// under 1ns and the last bucket everything from 2^(latency_buckets - 2) nanoseconds (about a second).
+inline constexpr std::size_t latency_buckets = 32;
+
+/**
+ * The recorded activity of one function.
+ */
+struct function_stats
 {
-    if (left.length() == right.length())
+    uint64_t calls{0};
+    /// The bytes every call processed, e.g. the haystack size of `find` or the output size of `join`.
+    uint64_t bytes{0};
+    uint64_t total_ns{0};
+    std::array<uint64_t, latency_buckets> latency{};
+
+    auto merge(const function_stats& other) -> void
     {
-        if constexpr (case_type == case_t::sensitive)
-        {
-            return left == right;
-        }
-        else
+        calls += other.calls;
+        bytes += other.bytes;
+        total_ns += other.total_ns;
+        for (std::size_t i = 0; i < latency_buckets; ++i)
         {
-            return std::equal(left.begin(), left.end(), right.begin(), right.end(), equal_uchar<case_t::insensitive>);
+            latency[i] += other.latency[i];
         }
     }
-
-    return false;
-}
+};
 
 /**
- * Finds needle in the haystack from pos with the given case type.
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param haystack The string to search in for `needle`.
- * @param needle The string to find in `haystack`.
- * @param pos The starting position within `haystack`, defaults to the beginning.
+ * A copy of the recorded activity of every function.  The counters only grow, subtract an earlier
+ * snapshot's values to get the activity in between.
  */
-template<case_t case_type = case_t::sensitive>
-auto find(std::string_view haystack, std::string_view needle, std::size_t pos = 0) -> std::string_view::size_type
+struct snapshot
 {
-    if constexpr (case_type == case_t::sensitive)
-    {
-        return haystack.find(needle, pos);
-    }
-    else
-    {
-        auto it = std::search(
-            haystack.begin() + pos, haystack.end(), needle.begin(), needle.end(), equal_uchar<case_t::insensitive>);
+    std::array<function_stats, function_count> functions{};
 
-        if (it != haystack.end())
-        {
-            return it - haystack.begin();
-        }
-        else
+    auto operator[](function f) const -> const function_stats& { return functions[static_cast<std::size_t>(f)]; }
+
+    /**
+     * Adds the activity of `other` to this snapshot, e.g. to combine snapshots from several processes.
+     */
+    auto merge(const snapshot& other) -> void
+    {
+        for (std::size_t i = 0; i < function_count; ++i)
         {
-            return std::string_view::npos;
+            functions[i].merge(other.functions[i]);
         }
     }
-}
+};
 
 /**
- * Reverise finds needle in the haystack from pos with the given case type.
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param haystack The string to search in for `needle`.
- * @param needle The string to find in `haystack`.
- * @param pos The starting position within `haystack`, defaults to the end.
+ * @return The activity recorded by the calling thread, empty if `enabled` is false.
  */
-template<case_t case_type = case_t::sensitive>
-auto rfind(std::string_view haystack, std::string_view needle, std::size_t pos = std::string_view::npos)
-    -> std::string_view::size_type
+auto thread_snapshot() -> snapshot;
+
+/**
+ * Reads every thread's counters without stopping them, so calls in flight may or may not be included.
+ * @return The activity recorded by every thread including exited ones, empty if `enabled` is false.
+ */
+auto global_snapshot() -> snapshot;
+
+/**
+ * @param f The function to get the name of.
+ * @return The name of `f`, e.g. "find".
+ */
+auto to_string(function f) -> std::string_view;
+} // namespace instrument
+
+#if CHAIN_INSTRUMENT
+namespace detail
 {
-    if constexpr (case_type == case_t::sensitive)
-    {
-        return haystack.rfind(needle, pos);
-    }
-    else
+/**
+ * One thread's counters, only that thread writes them so an update is a relaxed load and store
+ * rather than a locked read-modify-write.  Other threads read them for `global_snapshot()`.
+ */
+struct instrument_counters
+{
+    struct entry
     {
-        auto start = (pos == std::string_view::npos) ? haystack.rbegin() : haystack.rbegin() + (haystack.size() - pos);
+        std::atomic<uint64_t>                                         calls{0};
+        std::atomic<uint64_t>                                         bytes{0};
+        std::atomic<uint64_t>                                         total_ns{0};
+        std::array<std::atomic<uint64_t>, instrument::latency_buckets> latency{};
+    };
 
-        auto it = std::search(start, haystack.rend(), needle.rbegin(), needle.rend(), equal_uchar<case_t::insensitive>);
+    std::array<entry, instrument::function_count> functions{};
+};
 
-        if (it != haystack.rend())
-        {
-            return haystack.size() - (it - haystack.rbegin() + needle.size());
-        }
-        else
-        {
-            return std::string_view::npos;
-        }
-    }
-}
+/**
+ * @return The calling thread's counters, they are registered for `global_snapshot()` on first use.
+ */
+auto thread_instrument_counters() -> instrument_counters&;
 
 /**
- * @tparam case_type Is the comparison case sensitive or insensitive?
- * @param data The data to split by `delim`.
- * @param delim The delimeter to split `data` by.
- * @param out The string parts from the split.  This can be pre-allocated
- *            for the expected number of items to split.
+ * @return How many recorded calls the calling thread is inside of.
  */
-template<case_t case_type = case_t::sensitive>
-auto split(std::string_view data, std::string_view delim, std::vector<std::string_view>& out) -> void
+auto instrument_depth() -> std::size_t&;
+
+/**
+ * Records the call it is scoped to when destroyed, unless the thread is already inside a recorded
+ * call so library functions calling each other are only recorded once.
+ */
+class instrument_scope
 {
-    std::size_t length;
-    std::size_t start = 0;
+public:
+    instrument_scope(instrument::function f, std::size_t bytes)
+        : m_function(f),
+          m_bytes(bytes),
+          m_outer(instrument_depth()++ == 0),
+          m_start(m_outer ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{})
+    {
+    }
 
-    while (true)
+    instrument_scope(const instrument_scope&)                    = delete;
+    instrument_scope(instrument_scope&&)                         = delete;
+    auto operator=(const instrument_scope&) -> instrument_scope& = delete;
+    auto operator=(instrument_scope&&) -> instrument_scope&      = delete;
+
+    /**
+     * @param n Replaces the bytes given to the constructor, for calls that only know it at the end.
+     */
+    auto bytes(std::size_t n) -> void { m_bytes = n; }
+
+    ~instrument_scope()
     {
-        std::size_t next = find<case_type>(data, delim, start);
-        if (next == std::string_view::npos)
+        --instrument_depth();
+        if (!m_outer)
         {
-            // The length of this split is the full string length - start.
-            // This is also true if there were no delimiters found at all.
-            length = data.length() - start;
-            out.emplace_back(data.data() + start, length);
-            break;
+            return;
         }
 
-        // The length of this split is from start to next.
-        length = next - start;
-        out.emplace_back(data.data() + start, length);
+        const auto elapsed =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+        const auto ns = static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(elapsed.count(), 0));
 
-        // Update our iteration to skip the 'next' delimiter found.
-        start = next + delim.length();
+        std::size_t bucket{0};
+        for (uint64_t v = ns; v != 0 && bucket + 1 < instrument::latency_buckets; v >>= 1)
+        {
+            ++bucket;
+        }
+
+        auto& counters = thread_instrument_counters().functions[static_cast<std::size_t>(m_function)];
+        add(counters.calls, 1);
+        add(counters.bytes, m_bytes);
+        add(counters.total_ns, ns);
+        add(counters.latency[bucket], 1);
     }
-}
 
+private:
+    instrument::function                  m_function;
+    std::size_t                           m_bytes;
+    bool                                  m_outer;
+    std::chrono::steady_clock::time_point m_start;
+
+    static auto add(std::atomic<uint64_t>& counter, uint64_t value) -> void
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+};
+} // namespace detail
+
+    #define CHAIN_INSTRUMENT_SCOPE(f, bytes)                                                                     \
+        ::chain::str::detail::instrument_scope chain_instrument_scope_                                           \
+        {                                                                                                        \
+            ::chain::str::instrument::function::f, static_cast<std::size_t>(bytes)                               \
+        }
+    #define CHAIN_INSTRUMENT_BYTES(n) chain_instrument_scope_.bytes(static_cast<std::size_t>(n))
+#else
+    // Neither argument is evaluated.
+    #define CHAIN_INSTRUMENT_SCOPE(f, bytes) static_cast<void>(0)
+    #define CHAIN_INSTRUMENT_BYTES(n)       static_cast<void>(0)
+#endif
+
+namespace detail
+{
 /**
- * @tparam case_type Is the comparison case sensitive or insensitive?
- * @param data The data to split by `delim`.
- * @param delim The delimeter to split `data` by.
- * @param out The string parts from the split.  This can be pre-allocated
- *            for the expected number of items to split.
+ * Locale free ASCII lower case fold, bytes outside of 'A'-'Z' are returned as is.
+ * @param c The byte to fold.
+ * @return `c` folded to lower case.
  */
-template<case_t case_type = case_t::sensitive>
-auto split(std::string_view data, char delim, std::vector<std::string_view>& out) -> void
+constexpr auto ascii_lower(unsigned char c) -> unsigned char
 {
-    return split<case_type>(data, std::string_view{&delim, 1}, out);
+    return (static_cast<unsigned char>(c - 'A') < 26) ? static_cast<unsigned char>(c | 0x20) : c;
 }
 
 /**
- * @tparam case_type Is the comparison case sensitive or insensitive?
- * @param data The data to split by `delim`.
- * @param delim The delimeter to split `data` by.
- * @return The string parts from the split.
+ * Locale free ASCII upper case fold, bytes outside of 'a'-'z' are returned as is.
+ * @param c The byte to fold.
+ * @return `c` folded to upper case.
  */
-template<case_t case_type = case_t::sensitive>
-auto split(std::string_view data, std::string_view delim) -> std::vector<std::string_view>
+constexpr auto ascii_upper(unsigned char c) -> unsigned char
 {
-    std::vector<std::string_view> out{};
-    split<case_type>(data, delim, out);
-    return out;
+    return (static_cast<unsigned char>(c - 'a') < 26) ? static_cast<unsigned char>(c & ~0x20) : c;
 }
 
 /**
- * @tparam case_type Is the comparison case sensitive or insensitive?
- * @param data The data to split by `delim`.
- * @param delim The delimeter to split `data` by.
- * @return The string parts from the split.
+ * @param c The byte to check.
+ * @return True if `c` is whitespace in the "C" locale, ' ' or '\t' through '\r'.
  */
-template<case_t case_type = case_t::sensitive>
-auto split(std::string_view data, char delim) -> std::vector<std::string_view>
+constexpr auto ascii_space(unsigned char c) -> bool
 {
-    return split<case_type>(data, std::string_view{&delim, 1});
+    return c == ' ' || static_cast<unsigned char>(c - '\t') < 5;
 }
 
 /**
- * @tparam case_type Is the comparison case sensitive or insensitive?
- * @tparam T The output type that the `map_functor_type` maps into.
- * @tparam map_functor_type The function type to apply against each split item.
- * @param data The data to split by `delim`.
- * @param delim The delimeter to split `data` by.
- * @param map The map functor too apply to each split item.
- * @param out The string parts from the split.  This can be pre-allocated
- *            for the expected number of items to split.
+ * @param c The byte to check.
+ * @return True if `c` is a decimal digit in the "C" locale.
  */
-template<
-    typename T,
-    case_t case_type          = case_t::sensitive,
-    typename map_functor_type = std::function<T(std::string_view)>>
-auto split_map(std::string_view data, std::string_view delim, const map_functor_type& map, std::vector<T>& out) -> void
+constexpr auto ascii_digit(unsigned char c) -> bool
 {
-    std::size_t length;
-    std::size_t start = 0;
-
-    while (true)
-    {
-        std::size_t next = find<case_type>(data, delim, start);
-        if (next == std::string_view::npos)
-        {
-            // The length of this split is the full string length - start.
-            // This is also true if there were no delimiters found at all.
-            length = data.length() - start;
-            out.emplace_back(map(std::string_view{data.data() + start, length}));
-            break;
-        }
-
-        // The length of this split is from start to next.
-        length = next - start;
-        out.emplace_back(map(std::string_view{data.data() + start, length}));
-
-        // Update our iteration to skip the 'next' delimiter found.
-        start = next + delim.length();
-    }
+    return static_cast<unsigned char>(c - '0') < 10;
 }
 
 /**
- * @tparam case_type Is the comparison case sensitive or insensitive?
- * @tparam T The output type that the `map_functor_type` maps into.
- * @tparam map_functor_type The function type to apply against each split item.
- * @param data The data to split by `delim`.
- * @param delim The delimeter to split `data` by.
- * @param map The map functor too apply to each split item.
- * @param out The string parts from the split.  This can be pre-allocated
- *            for the expected number of items to split.
+ * @param c The byte to check.
+ * @return True if `c` is a hexadecimal digit in the "C" locale.
  */
-template<
-    typename T,
-    case_t case_type          = case_t::sensitive,
-    typename map_functor_type = std::function<T(std::string_view)>>
-auto split_map(std::string_view data, char delim, const map_functor_type& map, std::vector<T>& out) -> void
+constexpr auto ascii_xdigit(unsigned char c) -> bool
 {
-    split_map<T, case_type, map_functor_type>(data, std::string_view{&delim, 1}, map, out);
+    return ascii_digit(c) || static_cast<unsigned char>((c | 0x20) - 'a') < 6;
 }
 
 /**
- * @tparam case_type Is the comparison case sensitive or insensitive?
- * @tparam T The output type that the `map_functor_type` maps into.
- * @tparam map_functor_type The function type to apply against each split item.
- * @param data The data to split by `delim`.
- * @param delim The delimeter to split `data` by.
- * @param map The map functor too apply to each split item.
- * @return The string parts from the split.
+ * @return True while the caller is being evaluated at compile time.
  */
-template<
-    typename T,
-    case_t case_type          = case_t::sensitive,
-    typename map_functor_type = std::function<T(std::string_view)>>
-auto split_map(std::string_view data, std::string_view delim, const map_functor_type& map) -> std::vector<T>
+constexpr auto is_constant_evaluated() -> bool
 {
-    std::vector<T> out{};
-    split_map<T, case_type, map_functor_type>(data, delim, map, out);
-    return out;
+    return CHAIN_CONSTANT_EVALUATED();
 }
 
 /**
- * @tparam case_type Is the comparison case sensitive or insensitive?
- * @tparam T The output type that the `map_functor_type` maps into.
- * @tparam map_functor_type The function type to apply against each split item.
- * @param data The data to split by `delim`.
- * @param delim The delimeter to split `data` by.
- * @param map The map functor too apply to each split item.
- * @return The string parts from the split.
+ * Portable versions of the case insensitive engines for compile time evaluation, they have the
+ * same results as the SIMD kernels.
  */
-template<
-    typename T                = std::string_view,
-    case_t case_type          = case_t::sensitive,
-    typename map_functor_type = std::function<T(std::string_view)>>
-auto split_map(std::string_view data, char delim, const map_functor_type& map) -> std::vector<T>
+namespace constant
 {
-    std::vector<T> out{};
-    split_map<T, case_type, map_functor_type>(data, std::string_view{&delim, 1}, map, out);
-    return out;
-}
-
-/**
- * Splits the given data string by the given delimeter and calls a functor for each token.
- * @tparam functor_type std::invocable<void(std::string_view)>
- * @param data The string data to split by the given delimeter.
- * @param delim The delimeter to split the data by.
- * @param functor The functor to call for each tokenized part of the data.  By default this will
- *                be called for every tokenized part of the data, if at some point stopping is
- *                required then use a lambda or functor that returns a boolean.  After each token
- *                part return true to continue parsing or false to break out of parsing.
- */
-template<case_t case_type = case_t::sensitive, typename functor_type = std::function<void(std::string_view)>>
-auto split_for_each(std::string_view data, std::string_view delim, functor_type&& functor) -> void
+constexpr auto equal_insensitive(std::string_view left, std::string_view right) -> bool
 {
-    std::size_t length;
-    std::size_t start = 0;
-
-    while (true)
+    if (left.size() != right.size())
     {
-        std::size_t next = find<case_type>(data, delim, start);
-        if (next == std::string_view::npos)
-        {
-            // The length of this split is the full string length - start.
-            // This is also true if there were no delimiters found at all.
-            length = data.length() - start;
-            functor(std::string_view{data.data() + start, length});
-            break;
-        }
-
-        // The length of this split is from start to next.
-        length = next - start;
-
-        if constexpr (std::is_same_v<std::invoke_result_t<functor_type, std::string_view>, bool>)
-        {
-            // Call the users functor for this token part, if they return false stop parsing.
-            if (!functor(std::string_view{data.data() + start, length}))
-            {
-                break;
-            }
-        }
-        else
+        return false;
+    }
+    for (std::size_t i = 0; i < left.size(); ++i)
+    {
+        if (ascii_lower(static_cast<unsigned char>(left[i])) != ascii_lower(static_cast<unsigned char>(right[i])))
         {
-            functor(std::string_view{data.data() + start, length});
+            return false;
         }
-
-        // Update our iteration to skip the 'next' delimiter found.
-        start = next + delim.length();
     }
+    return true;
 }
 
-template<case_t case_type = case_t::sensitive, typename functor_type = std::function<bool(std::string_view)>>
-auto split_for_each(std::string_view data, char delim, functor_type&& functor) -> void
+constexpr auto find_insensitive(std::string_view haystack, std::string_view needle, std::size_t pos) -> std::size_t
 {
-    split_for_each<case_type, functor_type>(data, std::string_view{&delim, 1}, std::forward<functor_type>(functor));
+    if (pos > haystack.size())
+    {
+        return std::string_view::npos;
+    }
+    if (needle.empty())
+    {
+        return (pos < haystack.size()) ? pos : std::string_view::npos;
+    }
+    for (std::size_t i = pos; i + needle.size() <= haystack.size(); ++i)
+    {
+        if (equal_insensitive(haystack.substr(i, needle.size()), needle))
+        {
+            return i;
+        }
+    }
+    return std::string_view::npos;
 }
 
-/**
- * Joins a set of values together into a single string.  The values being joined
- * together must have an ostream operator<< function declared to convert to strings.
- * @tparam RangeType A container of values that can be converted into strings via operator<<.
- * @param parts The set of values to join together with `delim`.
- * @param delim The delimter to place between each joined part.
- * @return `parts` joined by `delim`.
- */
-template<typename RangeType>
-auto join(const RangeType& parts, std::string_view delim) -> std::string
+constexpr auto rfind_insensitive(std::string_view haystack, std::string_view needle, std::size_t pos) -> std::size_t
 {
-    thread_local std::stringstream ss{};
-
-    ss.clear();
-    ss.str("");
-    ss.copyfmt(g_ss_default_fmt);
-
-    bool first{true};
-    for (const auto& part : parts)
+    const std::size_t limit = std::min(pos, haystack.size());
+    if (needle.empty())
     {
-        if (first)
-        {
-            first = false;
-        }
-        else
+        return (limit > 0) ? limit : std::string_view::npos;
+    }
+    for (std::size_t i = limit + 1; i-- > needle.size();)
+    {
+        if (equal_insensitive(haystack.substr(i - needle.size(), needle.size()), needle))
         {
-            ss << delim;
+            return i - needle.size();
         }
-
-        ss << part;
     }
-
-    return ss.str();
+    return std::string_view::npos;
 }
 
-/**
- * Joins a set of values together into a single string.  The values being joined
- * together must have an ostream operator<< function declared to convert to strings.
- * @tparam RangeType A container of values that can be converted into strings via operator<<.
- * @param parts The set of values to join together with `delim`.
- * @param delim The delimter to place between each joined part.
- * @return `parts` joined by `delim`.
- */
-template<typename RangeType>
-auto join(const RangeType& parts, char delim) -> std::string
+constexpr auto trim_left(std::string_view data) -> std::size_t
 {
-    return join(parts, std::string_view{&delim, 1});
+    std::size_t i{0};
+    while (i < data.size() && ascii_space(static_cast<unsigned char>(data[i])))
+    {
+        ++i;
+    }
+    return i;
 }
 
-/**
- * Maps and joins a set of values together into a single string.  The values being joined
- * together must have an ostream operator<< function declared to convert to strings.
- * @tparam RangeType A container of values that can be converted into strings via operator<<.
- * @tparam map_functor_type A function to map each individual `parts` part before joining.
- * @param parts The set of values to join together with `delim`.
- * @param delim The delimter to place between each joined part.
- * @return Mapped `parts` joined by `delim`.
- */
-template<typename RangeType, typename map_functor_type>
-auto map_join(const RangeType& parts, std::string_view delim, const map_functor_type& map) -> std::string
+constexpr auto trim_right(std::string_view data) -> std::size_t
 {
-    thread_local std::stringstream ss{};
-
-    ss.clear();
-    ss.str("");
-    ss.copyfmt(g_ss_default_fmt);
-
-    bool first{true};
-    for (const auto& part : parts)
+    std::size_t end{data.size()};
+    while (end > 0 && ascii_space(static_cast<unsigned char>(data[end - 1])))
     {
-        if (first)
-        {
-            first = false;
-        }
-        else
-        {
-            ss << delim;
-        }
-
-        ss << map(part);
+        --end;
     }
-
-    return ss.str();
+    return data.size() - end;
 }
+} // namespace constant
 
-/**
- * Maps and joins a set of values together into a string.
- * @tparam RangeType A container of values that can be converted into strings via operator<<.
- * @tparam map_functor_type A function to map each individual `parts` part before joining.
- * @param parts The set of values to join together with `delim`.
- * @param delim The delimter to place between each joined part.
- * @return Mapped `parts` joined by `delim`.
- */
-template<typename RangeType, typename map_functor_type>
-auto map_join(const RangeType& parts, char delim, const map_functor_type& map) -> std::string
+#if CHAIN_INSTRUMENT
+template<typename functor_type>
+auto instrumented_call(instrument::function f, std::size_t bytes, const functor_type& functor) -> decltype(functor())
 {
-    return map_join(parts, std::string_view{&delim, 1}, map);
+    const instrument_scope scope{f, bytes};
+    return functor();
 }
+#endif
 
 /**
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data The data to see if it starts with `begin`.
- * @param begin Value to check if `data` starts with.
- * @return True if `data` starts with `begin`.  Equal length strings will match.
+ * Calls `functor` recorded as a call to `f` like `CHAIN_INSTRUMENT_SCOPE`, for the constexpr
+ * functions which can't hold a scope.  Compile time calls aren't recorded.
  */
-template<case_t case_type = case_t::sensitive>
-auto starts_with(std::string_view data, std::string_view begin) -> bool
+template<typename functor_type>
+constexpr auto instrumented(
+    [[maybe_unused]] instrument::function f, [[maybe_unused]] std::size_t bytes, const functor_type& functor)
+    -> decltype(functor())
 {
-    if (data.length() >= begin.length())
+#if CHAIN_INSTRUMENT
+    if (!is_constant_evaluated())
     {
-        return std::equal(begin.begin(), begin.end(), data.begin(), equal_uchar<case_type>);
+        return instrumented_call(f, bytes, functor);
     }
-    return false;
+#endif
+    return functor();
 }
 
 /**
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data The data to see if it ends with `begin`.
- * @param begin Value to check if `data` ends with.
- * @return True if `data` ends with `begin`.  Equal length strings will match.
+ * ASCII case insensitive equality, this is the engine for `equal<case_t::insensitive>`.
  */
-template<case_t case_type = case_t::sensitive>
-auto ends_with(std::string_view data, std::string_view end) -> bool
-{
-    if (data.length() >= end.length())
-    {
-        return std::equal(end.rbegin(), end.rend(), data.rbegin(), equal_uchar<case_type>);
-    }
-    return false;
-}
+auto equal_insensitive(std::string_view left, std::string_view right) -> bool;
 
 /**
- * @param data The data to transform to lower case.  Uses std::tolower().
+ * Whitespace trimming engines for the `trim_*view(data)` functions at the active `simd_level`.
  */
-auto to_lower(std::string& data) -> void;
+auto trim_left_view(std::string_view data) -> std::string_view;
+auto trim_right_view(std::string_view data) -> std::string_view;
+auto trim_view(std::string_view data) -> std::string_view;
 
 /**
- * @param data The data to transform to lower case.  uses std::tolower().
- * @return A copy of `daa` transformed to lowercase.
+ * ASCII case insensitive forward search, this is the engine for `find<case_t::insensitive>`.
+ * Uses SIMD first/last byte candidate filtering at the active `simd_level`.
  */
-auto to_lower_copy(std::string_view data) -> std::string;
+auto find_insensitive(std::string_view haystack, std::string_view needle, std::size_t pos) -> std::size_t;
 
 /**
- * @param data The data to transform to upper case.  Uses std::toupper().
+ * ASCII case insensitive reverse search, this is the engine for `rfind<case_t::insensitive>`.
+ * Uses SIMD first/last byte candidate filtering at the active `simd_level`.
  */
-auto to_upper(std::string& data) -> void;
+auto rfind_insensitive(std::string_view haystack, std::string_view needle, std::size_t pos) -> std::size_t;
 
 /**
- * @param data The data to transform to upper case.  Uses std::toupper().
- * @return A copy of `data` transformed to uppercase.
+ * Counts and optionally collects every match of `needle`, this is the engine for `count` and
+ * `find_all`.  Uses SIMD first/last byte candidate filtering at the active `simd_level`, single
+ * byte counts are a compare and popcount per vector.
+ * @param fold True for ASCII case insensitive matching.
+ * @param overlapping True to report overlapping matches.
+ * @param out If not null every match offset is appended.
+ * @return The number of matches.
  */
-auto to_upper_copy(std::string_view data) -> std::string;
+auto find_all(
+    std::string_view          haystack,
+    std::string_view          needle,
+    bool                      fold,
+    bool                      overlapping,
+    std::vector<std::size_t>* out) -> std::size_t;
+
+} // namespace detail
 
 /**
- * @param data Trims the left side with std::isspace().
+ * Comapres two unsigned characeters for equality.
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @param left Left unsigned char to compare.
+ * @param right Right unsigned char to compare.
+ * @return True if left is the same as right with case sensitivity.
  */
-auto trim_left(std::string& data) -> void;
+template<case_t case_type = case_t::sensitive>
+constexpr auto equal_uchar(unsigned char left, unsigned char right) -> bool
+{
+    if constexpr (case_type == case_t::sensitive)
+    {
+        return left == right;
+    }
+    else
+    {
+        return detail::ascii_lower(left) == detail::ascii_lower(right);
+    }
+}
 
 /**
+ * Compares two string views with the given sensitivity for equality.  Case insensitive
+ * comparisons fold ASCII characters only.
  * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the left side of this data with `to_remove`.
- * @param to_remove The value on the left side to remove from `data`.
+ * @param left Left string view to compare.
+ * @param right Right string view to compare.
+ * @return True if left is the same as right.
  */
 template<case_t case_type = case_t::sensitive>
-auto trim_left(std::string& data, std::string_view to_remove) -> void
+constexpr auto equal(std::string_view left, std::string_view right) -> bool
 {
-    if (!data.empty() && !to_remove.empty())
+    if constexpr (case_type == case_t::sensitive)
     {
-        std::size_t      total_remove_size = 0;
-        std::string_view sv{data.data(), data.length()};
-        while (starts_with<case_type>(sv, to_remove))
+        return left == right;
+    }
+    else if (detail::is_constant_evaluated())
+    {
+        return detail::constant::equal_insensitive(left, right);
+    }
+    else
+    {
+        return detail::equal_insensitive(left, right);
+    }
+}
+
+/**
+ * Finds needle in the haystack from pos with the given case type.  Case insensitive
+ * searches fold ASCII characters only.
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param haystack The string to search in for `needle`.
+ * @param needle The string to find in `haystack`.
+ * @param pos The starting position within `haystack`, defaults to the beginning.
+ */
+template<case_t case_type = case_t::sensitive>
+constexpr auto find(std::string_view haystack, std::string_view needle, std::size_t pos = 0)
+    -> std::string_view::size_type
+{
+    return detail::instrumented(instrument::function::find, haystack.size(), [&]() {
+        if constexpr (case_type == case_t::sensitive)
         {
-            sv.remove_prefix(to_remove.size());
-            total_remove_size += to_remove.size();
+            return haystack.find(needle, pos);
         }
-
-        if (total_remove_size > 0)
+        else if (detail::is_constant_evaluated())
         {
-            data.erase(0, total_remove_size);
+            return detail::constant::find_insensitive(haystack, needle, pos);
         }
-    }
+        else
+        {
+            return detail::find_insensitive(haystack, needle, pos);
+        }
+    });
 }
 
 /**
+ * Reverise finds needle in the haystack from pos with the given case type.  Case insensitive
+ * searches fold ASCII characters only and require the match to end before `pos`.
  * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the left side of this data with `to_remove`.
- * @param to_remove The values on the left side to remove from `data`.
+ * @param haystack The string to search in for `needle`.
+ * @param needle The string to find in `haystack`.
+ * @param pos The starting position within `haystack`, defaults to the end.
  */
 template<case_t case_type = case_t::sensitive>
-auto trim_left(std::string& data, const std::vector<std::string_view>& to_remove) -> void
+constexpr auto rfind(std::string_view haystack, std::string_view needle, std::size_t pos = std::string_view::npos)
+    -> std::string_view::size_type
 {
-    if (!data.empty() && !to_remove.empty())
-    {
-        std::size_t      total_remove_size = 0;
-        std::string_view sv{data.data(), data.length()};
-
-        while (true)
+    return detail::instrumented(instrument::function::rfind, haystack.size(), [&]() {
+        if constexpr (case_type == case_t::sensitive)
         {
-            bool had_removal{false};
-
-            for (const auto& remove : to_remove)
-            {
-                while (starts_with<case_type>(sv, remove))
-                {
-                    sv.remove_prefix(remove.size());
-                    total_remove_size += remove.size();
-                    had_removal = true;
-                }
-            }
-
-            if (!had_removal)
-            {
-                break;
-            }
+            return haystack.rfind(needle, pos);
         }
-
-        if (total_remove_size > 0)
+        else if (detail::is_constant_evaluated())
         {
-            data.erase(0, total_remove_size);
+            return detail::constant::rfind_insensitive(haystack, needle, pos);
         }
-    }
+        else
+        {
+            return detail::rfind_insensitive(haystack, needle, pos);
+        }
+    });
 }
 
 /**
- * @param data Trims the left side of this data with `to_remove`.
- * @return A string view of `data` with the left side of `to_remove` removed.
+ * Counts the occurrences of `needle` in `haystack`.
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @tparam overlap Count overlapping occurrences or not, e.g. "aa" is in "aaa" once or twice.
+ * @param haystack The string to search in for `needle`.
+ * @param needle The string to count in `haystack`, an empty needle is never counted.
+ * @return The number of occurrences.
  */
-auto trim_left_view(std::string_view data) -> std::string_view;
+template<case_t case_type = case_t::sensitive, overlap_t overlap = overlap_t::non_overlapping>
+auto count(std::string_view haystack, std::string_view needle) -> std::size_t
+{
+    return detail::find_all(
+        haystack, needle, case_type == case_t::insensitive, overlap == overlap_t::overlapping, nullptr);
+}
 
 /**
+ * Finds the offset of every occurrence of `needle` in `haystack`.
  * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the left side of this data with `to_remove`.
- * @param to_remove The value on the left side to remove from `data`.
- * @return A string view of `data` with the left side of `to_remove` removed.
+ * @tparam overlap Report overlapping occurrences or not.
+ * @param haystack The string to search in for `needle`.
+ * @param needle The string to find in `haystack`, an empty needle is never found.
+ * @param out The offsets of each occurrence are appended to this.  This can be pre-allocated
+ *            for the expected number of occurrences.
  */
-template<case_t case_type = case_t::sensitive>
-auto trim_left_view(std::string_view data, std::string_view to_remove) -> std::string_view
+template<case_t case_type = case_t::sensitive, overlap_t overlap = overlap_t::non_overlapping>
+auto find_all(std::string_view haystack, std::string_view needle, std::vector<std::size_t>& out) -> void
 {
-    if (!data.empty() && !to_remove.empty())
-    {
-        while (starts_with<case_type>(data, to_remove))
-        {
-            data.remove_prefix(to_remove.size());
-        }
-    }
-
-    return data;
+    detail::find_all(haystack, needle, case_type == case_t::insensitive, overlap == overlap_t::overlapping, &out);
 }
 
 /**
+ * Finds the offset of every occurrence of `needle` in `haystack`.
  * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the left side of this data with `to_remove`.
- * @param to_remove The values on the left side to remove from `data`.
- * @return A string view of `data` with the left side of `to_remove` removed.
+ * @tparam overlap Report overlapping occurrences or not.
+ * @param haystack The string to search in for `needle`.
+ * @param needle The string to find in `haystack`, an empty needle is never found.
+ * @return The offsets of each occurrence.
  */
-template<case_t case_type = case_t::sensitive>
-auto trim_left_view(std::string_view data, const std::vector<std::string_view>& to_remove) -> std::string_view
+template<case_t case_type = case_t::sensitive, overlap_t overlap = overlap_t::non_overlapping>
+auto find_all(std::string_view haystack, std::string_view needle) -> std::vector<std::size_t>
 {
-    if (!data.empty() && !to_remove.empty())
+    std::vector<std::size_t> out{};
+    find_all<case_type, overlap>(haystack, needle, out);
+    return out;
+}
+
+/**
+ * A needle that is compiled once and then searched for many times.  The Boyer-Moore-Horspool
+ * skip tables are built on construction so hot loops searching for the same needle or
+ * delimiter don't re-derive them on every call.  Results are identical to the free
+ * `find`/`rfind` functions with the same `case_type`.
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ */
+template<case_t case_type = case_t::sensitive>
+class searcher
+{
+public:
+    /**
+     * @param needle The value to search for, a copy is taken so it does not need to outlive
+     *               the searcher.
+     */
+    explicit searcher(std::string_view needle) : m_needle(needle), m_skip(), m_rskip()
+    {
+        const std::size_t n = m_needle.size();
+
+        if constexpr (case_type == case_t::insensitive)
+        {
+            for (auto& c : m_needle)
+            {
+                c = static_cast<char>(detail::ascii_lower(static_cast<unsigned char>(c)));
+            }
+        }
+
+        // Skips are capped at 255 to keep both tables within a few cache lines, a shorter
+        // skip than the maximum is always safe.
+        const auto cap = static_cast<uint8_t>(std::min<std::size_t>(n, 255));
+        m_skip.fill(cap);
+        m_rskip.fill(cap);
+
+        for (std::size_t i = 0; i + 1 < n; ++i)
+        {
+            m_skip[static_cast<unsigned char>(m_needle[i])] =
+                static_cast<uint8_t>(std::min<std::size_t>(n - 1 - i, 255));
+        }
+
+        for (std::size_t i = n; i-- > 1;)
+        {
+            m_rskip[static_cast<unsigned char>(m_needle[i])] = static_cast<uint8_t>(std::min<std::size_t>(i, 255));
+        }
+    }
+
+    /**
+     * @return The needle being searched for, case insensitive searchers store it lower cased.
+     */
+    auto needle() const -> std::string_view { return m_needle; }
+
+    /**
+     * @return The length of the needle.
+     */
+    auto size() const -> std::size_t { return m_needle.size(); }
+
+    /**
+     * Finds the needle in the haystack from pos.
+     * @param haystack The string to search in for the needle.
+     * @param pos The starting position within `haystack`, defaults to the beginning.
+     */
+    auto find(std::string_view haystack, std::size_t pos = 0) const -> std::string_view::size_type
+    {
+        const std::size_t n = m_needle.size();
+        if (n <= 1)
+        {
+            // memchr and the SIMD kernels beat any skip table for a single byte.
+            return chain::str::find<case_type>(haystack, m_needle, pos);
+        }
+
+        if (pos > haystack.size() || n > haystack.size() - pos)
+        {
+            return std::string_view::npos;
+        }
+
+        const char*       data = haystack.data();
+        const std::size_t last = haystack.size() - n;
+        const auto        tail = static_cast<unsigned char>(m_needle.back());
+
+        std::size_t i = pos;
+        while (i <= last)
+        {
+            const unsigned char c = fold(data[i + n - 1]);
+            if (c == tail && matches(data + i, 0, n - 1))
+            {
+                return i;
+            }
+            i += m_skip[c];
+        }
+
+        return std::string_view::npos;
+    }
+
+    /**
+     * Reverse finds the needle in the haystack from pos.
+     * @param haystack The string to search in for the needle.
+     * @param pos The starting position within `haystack`, defaults to the end.
+     */
+    auto rfind(std::string_view haystack, std::size_t pos = std::string_view::npos) const
+        -> std::string_view::size_type
+    {
+        const std::size_t n = m_needle.size();
+        if (n <= 1)
+        {
+            return chain::str::rfind<case_type>(haystack, m_needle, pos);
+        }
+
+        // The highest candidate start, this follows the free rfind() semantics for each case type.
+        std::size_t start{0};
+        if constexpr (case_type == case_t::sensitive)
+        {
+            if (n > haystack.size())
+            {
+                return std::string_view::npos;
+            }
+            start = std::min(pos, haystack.size() - n);
+        }
+        else
+        {
+            const std::size_t limit = std::min(pos, haystack.size());
+            if (n > limit)
+            {
+                return std::string_view::npos;
+            }
+            start = limit - n;
+        }
+
+        const char* data = haystack.data();
+        const auto  head = static_cast<unsigned char>(m_needle.front());
+
+        while (true)
+        {
+            const unsigned char c = fold(data[start]);
+            if (c == head && matches(data + start, 1, n))
+            {
+                return start;
+            }
+
+            const std::size_t shift = m_rskip[c];
+            if (shift > start)
+            {
+                break;
+            }
+            start -= shift;
+        }
+
+        return std::string_view::npos;
+    }
+
+    /**
+     * Finds every occurrence of the needle in the haystack.
+     * @tparam overlap Report overlapping occurrences or not.
+     * @param haystack The string to search in for the needle.
+     * @param out The offsets of each occurrence are appended to this.
+     */
+    template<overlap_t overlap = overlap_t::non_overlapping>
+    auto find_all(std::string_view haystack, std::vector<std::size_t>& out) const -> void
+    {
+        for_each_match<overlap>(haystack, [&out](std::size_t pos) { out.push_back(pos); });
+    }
+
+    /**
+     * Finds every occurrence of the needle in the haystack.
+     * @tparam overlap Report overlapping occurrences or not.
+     * @param haystack The string to search in for the needle.
+     * @return The offsets of each occurrence.
+     */
+    template<overlap_t overlap = overlap_t::non_overlapping>
+    auto find_all(std::string_view haystack) const -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> out{};
+        find_all<overlap>(haystack, out);
+        return out;
+    }
+
+    /**
+     * Counts the occurrences of the needle in the haystack.
+     * @tparam overlap Count overlapping occurrences or not.
+     * @param haystack The string to search in for the needle.
+     * @return The number of occurrences, an empty needle is never counted.
+     */
+    template<overlap_t overlap = overlap_t::non_overlapping>
+    auto count(std::string_view haystack) const -> std::size_t
+    {
+        std::size_t found{0};
+        for_each_match<overlap>(haystack, [&found](std::size_t) { ++found; });
+        return found;
+    }
+
+private:
+    /// The needle, lower cased for case insensitive searchers.
+    std::string m_needle;
+    /// Forward skip by the byte under the last position of the window.
+    std::array<uint8_t, 256> m_skip;
+    /// Reverse skip by the byte under the first position of the window.
+    std::array<uint8_t, 256> m_rskip;
+
+    static auto fold(char c) -> unsigned char
+    {
+        if constexpr (case_type == case_t::sensitive)
+        {
+            return static_cast<unsigned char>(c);
+        }
+        else
+        {
+            return detail::ascii_lower(static_cast<unsigned char>(c));
+        }
+    }
+
+    template<overlap_t overlap, typename functor_type>
+    auto for_each_match(std::string_view haystack, functor_type&& functor) const -> void
+    {
+        if (m_needle.empty())
+        {
+            return;
+        }
+
+        std::size_t pos{0};
+        while ((pos = find(haystack, pos)) != std::string_view::npos)
+        {
+            functor(pos);
+            pos += (overlap == overlap_t::overlapping) ? 1 : m_needle.size();
+        }
+    }
+
+    /**
+     * @return True if `candidate` matches the needle for bytes [first, last).
+     */
+    auto matches(const char* candidate, std::size_t first, std::size_t last) const -> bool
+    {
+        if constexpr (case_type == case_t::sensitive)
+        {
+            return std::char_traits<char>::compare(candidate + first, m_needle.data() + first, last - first) == 0;
+        }
+        else
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                if (fold(candidate[i]) != static_cast<unsigned char>(m_needle[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+};
+
+/**
+ * A single needle occurrence within a haystack reported by a `multi_searcher`.
+ */
+struct multi_match
+{
+    /// The index of the matched needle in the `multi_searcher`'s needles.
+    std::size_t pattern;
+    /// The offset in the haystack the match starts at.
+    std::size_t offset;
+    /// The length of the matched needle.
+    std::size_t length;
+};
+
+/**
+ * A set of needles compiled into an Aho-Corasick automaton so every occurrence of every needle
+ * is found in a single pass over the haystack.  The automaton is stored as a dense transition
+ * table over byte equivalence classes, bytes that appear in no needle share one class, so each
+ * haystack byte costs one table lookup regardless of the number of needles.
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ */
+template<case_t case_type = case_t::sensitive>
+class multi_searcher
+{
+public:
+    using match = multi_match;
+
+    /**
+     * @param needles The values to search for, copies are not needed after construction.  Empty
+     *                needles never match.
+     */
+    explicit multi_searcher(const std::vector<std::string_view>& needles)
+        : m_classes(),
+          m_class_count(1),
+          m_table(),
+          m_output_offsets(),
+          m_outputs(),
+          m_lengths(),
+          m_max_length(0)
+    {
+        // Byte equivalence classes, class 0 is every byte that appears in no needle.
+        m_classes.fill(0);
+        for (const auto& needle : needles)
+        {
+            for (const auto c : needle)
+            {
+                const auto b = fold(c);
+                if (m_classes[b] == 0)
+                {
+                    m_classes[b] = static_cast<uint16_t>(m_class_count++);
+                }
+            }
+        }
+        if constexpr (case_type == case_t::insensitive)
+        {
+            for (unsigned char c = 'A'; c <= 'Z'; ++c)
+            {
+                m_classes[c] = m_classes[detail::ascii_lower(c)];
+            }
+        }
+
+        // Build the trie, 0 is the root and doubles as "no edge" since nothing transitions back into it.
+        std::vector<std::vector<uint32_t>> own{};
+        add_state(own);
+        m_lengths.reserve(needles.size());
+        for (std::size_t id = 0; id < needles.size(); ++id)
+        {
+            m_lengths.push_back(needles[id].size());
+            m_max_length = std::max(m_max_length, needles[id].size());
+            if (needles[id].empty())
+            {
+                continue;
+            }
+
+            uint32_t state{0};
+            for (const auto c : needles[id])
+            {
+                // Adding a state grows the table so index into it again afterwards.
+                const std::size_t edge = state * m_class_count + m_classes[fold(c)];
+                if (m_table[edge] == 0)
+                {
+                    const uint32_t child = add_state(own);
+                    m_table[edge]        = child;
+                }
+                state = m_table[edge];
+            }
+            own[state].push_back(static_cast<uint32_t>(id));
+        }
+
+        // Breadth first fill in the failure transitions so the table becomes a full DFA.  A state's
+        // row only holds trie edges until it is visited, and its failure state is always shallower.
+        const std::size_t                  states = own.size();
+        std::vector<uint32_t>              fail(states, 0);
+        std::vector<uint32_t>              order{0};
+        std::vector<std::vector<uint32_t>> outputs(states);
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            const uint32_t s = order[i];
+            outputs[s]       = own[s];
+            if (s != 0)
+            {
+                const auto& inherited = outputs[fail[s]];
+                outputs[s].insert(outputs[s].end(), inherited.begin(), inherited.end());
+            }
+
+            for (std::size_t c = 0; c < m_class_count; ++c)
+            {
+                auto&          next     = m_table[s * m_class_count + c];
+                const uint32_t fallback = (s == 0) ? 0 : m_table[fail[s] * m_class_count + c];
+                if (next != 0)
+                {
+                    fail[next] = fallback;
+                    order.push_back(next);
+                }
+                else
+                {
+                    next = fallback;
+                }
+            }
+        }
+
+        m_output_offsets.reserve(states + 1);
+        for (const auto& out : outputs)
+        {
+            m_output_offsets.push_back(static_cast<uint32_t>(m_outputs.size()));
+            m_outputs.insert(m_outputs.end(), out.begin(), out.end());
+        }
+        m_output_offsets.push_back(static_cast<uint32_t>(m_outputs.size()));
+    }
+
+    /**
+     * @return The number of needles this searcher was built with.
+     */
+    auto size() const -> std::size_t { return m_lengths.size(); }
+
+    /**
+     * Scans the haystack once and calls a functor for every occurrence of every needle, including
+     * overlapping ones.  Matches are reported in the order they end, matches ending at the same
+     * offset are reported longest first.
+     * @tparam functor_type std::invocable<void(match)>
+     * @param haystack The string to search in.
+     * @param functor The functor to call for each match.  If it returns a boolean then returning
+     *                false stops the scan.
+     */
+    template<typename functor_type>
+    auto find_for_each(std::string_view haystack, functor_type&& functor) const -> void
+    {
+        const auto*     data  = reinterpret_cast<const unsigned char*>(haystack.data());
+        const uint32_t* table = m_table.data();
+        uint32_t        state{0};
+
+        for (std::size_t i = 0; i < haystack.size(); ++i)
+        {
+            state = table[state * m_class_count + m_classes[data[i]]];
+
+            const uint32_t begin = m_output_offsets[state];
+            const uint32_t end   = m_output_offsets[state + 1];
+            for (uint32_t o = begin; o < end; ++o)
+            {
+                const std::size_t id     = m_outputs[o];
+                const match       result = match{id, i + 1 - m_lengths[id], m_lengths[id]};
+
+                if constexpr (std::is_same_v<std::invoke_result_t<functor_type, match>, bool>)
+                {
+                    if (!functor(result))
+                    {
+                        return;
+                    }
+                }
+                else
+                {
+                    functor(result);
+                }
+            }
+        }
+    }
+
+    /**
+     * Scans the haystack once and calls a functor for the non-overlapping leftmost-longest matches:
+     * the match starting first wins, the longest needle wins among those starting at the same offset
+     * and the lowest needle index breaks ties, then scanning resumes after the match.
+     * @tparam functor_type std::invocable<void(match)>
+     * @param haystack The string to search in.
+     * @param functor The functor to call for each match in haystack order.  If it returns a boolean
+     *                then returning false stops the scan.
+     */
+    template<typename functor_type>
+    auto find_leftmost_longest(std::string_view haystack, functor_type&& functor) const -> void
+    {
+        if (m_max_length == 0)
+        {
+            return;
+        }
+
+        // The longest match seen for each start in the last `m_max_length` bytes, a start is
+        // settled once the scan is `m_max_length` bytes past it since no longer match can begin there.
+        // Short needle sets keep the window on the stack so a scan doesn't allocate.
+        const std::size_t     window = m_max_length;
+        std::array<match, 32> local{};
+        std::vector<match>    heap{};
+        match*                pending = local.data();
+        std::size_t           cursor{0};
+        if (window > local.size())
+        {
+            heap.assign(window, match{0, 0, 0});
+            pending = heap.data();
+        }
+
+        auto settle = [&](std::size_t start) -> bool {
+            auto& best = pending[start % window];
+            if (best.length == 0)
+            {
+                return true;
+            }
+
+            const match result = best;
+            best.length        = 0;
+            if (result.offset < cursor)
+            {
+                return true;
+            }
+            cursor = result.offset + result.length;
+
+            if constexpr (std::is_same_v<std::invoke_result_t<functor_type, match>, bool>)
+            {
+                return functor(result);
+            }
+            else
+            {
+                functor(result);
+                return true;
+            }
+        };
+
+        const auto*     data  = reinterpret_cast<const unsigned char*>(haystack.data());
+        const uint32_t* table = m_table.data();
+        uint32_t        state{0};
+
+        for (std::size_t i = 0; i < haystack.size(); ++i)
+        {
+            state = table[state * m_class_count + m_classes[data[i]]];
+
+            const uint32_t begin = m_output_offsets[state];
+            const uint32_t end   = m_output_offsets[state + 1];
+            for (uint32_t o = begin; o < end; ++o)
+            {
+                const std::size_t id    = m_outputs[o];
+                const std::size_t start = i + 1 - m_lengths[id];
+                auto&             best  = pending[start % window];
+                if (start >= cursor &&
+                    (best.length < m_lengths[id] || (best.length == m_lengths[id] && id < best.pattern)))
+                {
+                    best = match{id, start, m_lengths[id]};
+                }
+            }
+
+            if (i + 1 >= window && !settle(i + 1 - window))
+            {
+                return;
+            }
+        }
+
+        const std::size_t first = (haystack.size() >= window) ? haystack.size() + 1 - window : 0;
+        for (std::size_t start = first; start < haystack.size(); ++start)
+        {
+            if (!settle(start))
+            {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @param haystack The string to search in.
+     * @param out Every occurrence of every needle is appended in the order `find_for_each` reports them.
+     */
+    auto find_all(std::string_view haystack, std::vector<match>& out) const -> void
+    {
+        find_for_each(haystack, [&out](const match& m) { out.push_back(m); });
+    }
+
+    /**
+     * @param haystack The string to search in.
+     * @return Every occurrence of every needle in the order `find_for_each` reports them.
+     */
+    auto find_all(std::string_view haystack) const -> std::vector<match>
+    {
+        std::vector<match> out{};
+        find_all(haystack, out);
+        return out;
+    }
+
+    /**
+     * @param haystack The string to search in.
+     * @return The first match to complete in the haystack, if any needle is present.
+     */
+    auto find_any(std::string_view haystack) const -> std::optional<match>
+    {
+        std::optional<match> found{};
+        find_for_each(haystack, [&found](const match& m) -> bool {
+            found = m;
+            return false;
+        });
+        return found;
+    }
+
+private:
+    /// Byte to equivalence class, case insensitive searchers map both cases to the same class.
+    std::array<uint16_t, 256> m_classes;
+    /// The number of equivalence classes, the width of each row in `m_table`.
+    std::size_t m_class_count;
+    /// Dense `states * m_class_count` transition table.
+    std::vector<uint32_t> m_table;
+    /// `m_outputs[m_output_offsets[s]..m_output_offsets[s + 1]]` are the needles matched entering state `s`.
+    std::vector<uint32_t> m_output_offsets;
+    /// Flattened needle ids for every state including those inherited through failure links.
+    std::vector<uint32_t> m_outputs;
+    /// The length of each needle by id.
+    std::vector<std::size_t> m_lengths;
+    /// The length of the longest needle.
+    std::size_t m_max_length;
+
+    static auto fold(char c) -> unsigned char
+    {
+        if constexpr (case_type == case_t::sensitive)
+        {
+            return static_cast<unsigned char>(c);
+        }
+        else
+        {
+            return detail::ascii_lower(static_cast<unsigned char>(c));
+        }
+    }
+
+    auto add_state(std::vector<std::vector<uint32_t>>& own) -> uint32_t
+    {
+        m_table.resize(m_table.size() + m_class_count, 0);
+        own.emplace_back();
+        return static_cast<uint32_t>(own.size() - 1);
+    }
+};
+
+namespace detail
+{
+/**
+ * Sets bit `i % 64` of `masks[i / 64]` for every byte `i` of `data` equal to `c`, unused bits of the
+ * final mask are zero.  Uses the active `simd_level`.
+ * @param fold True to compare with ASCII case folding, `c` must already be lower case.
+ * @param masks Must hold `(size + 63) / 64` masks.
+ */
+auto byte_masks(const char* data, std::size_t size, unsigned char c, bool fold, uint64_t* masks) -> void;
+
+/**
+ * Single byte split engine shared by every `char` delimeter overload.  The delimeter positions of
+ * each 1 KiB block are built as 64 bit masks by `byte_masks` and walked with count trailing zeros,
+ * so there is no per part search call.
+ * @param functor Called with each part, if it returns a boolean then returning false stops before
+ *                the final part.
+ */
+template<case_t case_type, typename functor_type>
+auto split_byte(std::string_view data, char delim, functor_type&& functor) -> void
+{
+    constexpr std::size_t block_size = 1024;
+
+    auto c    = static_cast<unsigned char>(delim);
+    bool fold = false;
+    if constexpr (case_type == case_t::insensitive)
+    {
+        fold = ascii_lower(c) != ascii_upper(c);
+        c    = ascii_lower(c);
+    }
+
+    std::array<uint64_t, block_size / 64> masks;
+    std::size_t                           start{0};
+
+    for (std::size_t base = 0; base < data.size(); base += block_size)
+    {
+        const std::size_t length = std::min(block_size, data.size() - base);
+        byte_masks(data.data() + base, length, c, fold, masks.data());
+
+        for (std::size_t m = 0; m < (length + 63) / 64; ++m)
+        {
+            uint64_t mask = masks[m];
+            while (mask != 0)
+            {
+                const std::size_t      next = base + m * 64 + static_cast<std::size_t>(__builtin_ctzll(mask));
+                const std::string_view part{data.data() + start, next - start};
+                start = next + 1;
+                mask &= mask - 1;
+
+                if constexpr (std::is_same_v<std::invoke_result_t<functor_type, std::string_view>, bool>)
+                {
+                    if (!functor(part))
+                    {
+                        return;
+                    }
+                }
+                else
+                {
+                    functor(part);
+                }
+            }
+        }
+    }
+
+    functor(std::string_view{data.data() + start, data.size() - start});
+}
+
+} // namespace detail
+
+/**
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @param data The data to split by `delim`.
+ * @param delim The delimeter to split `data` by.
+ * @param out The string parts from the split.  This can be pre-allocated
+ *            for the expected number of items to split.
+ */
+template<case_t case_type = case_t::sensitive>
+auto split(std::string_view data, std::string_view delim, std::vector<std::string_view>& out) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(split, data.size());
+    std::size_t length;
+    std::size_t start = 0;
+
+    while (true)
+    {
+        std::size_t next = find<case_type>(data, delim, start);
+        if (next == std::string_view::npos)
+        {
+            // The length of this split is the full string length - start.
+            // This is also true if there were no delimiters found at all.
+            length = data.length() - start;
+            out.emplace_back(data.data() + start, length);
+            break;
+        }
+
+        // The length of this split is from start to next.
+        length = next - start;
+        out.emplace_back(data.data() + start, length);
+
+        // Update our iteration to skip the 'next' delimiter found.
+        start = next + delim.length();
+    }
+}
+
+/**
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @param data The data to split by `delim`.
+ * @param delim The delimeter to split `data` by.
+ * @param out The string parts from the split.  This can be pre-allocated
+ *            for the expected number of items to split.
+ */
+template<case_t case_type = case_t::sensitive>
+auto split(std::string_view data, char delim, std::vector<std::string_view>& out) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(split, data.size());
+    detail::split_byte<case_type>(data, delim, [&out](std::string_view part) { out.emplace_back(part); });
+}
+
+/**
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @param data The data to split by `delim`.
+ * @param delim The delimeter to split `data` by.
+ * @return The string parts from the split.
+ */
+template<case_t case_type = case_t::sensitive>
+auto split(std::string_view data, std::string_view delim) -> std::vector<std::string_view>
+{
+    std::vector<std::string_view> out{};
+    split<case_type>(data, delim, out);
+    return out;
+}
+
+/**
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @param data The data to split by `delim`.
+ * @param delim The delimeter to split `data` by.
+ * @return The string parts from the split.
+ */
+template<case_t case_type = case_t::sensitive>
+auto split(std::string_view data, char delim) -> std::vector<std::string_view>
+{
+    std::vector<std::string_view> out{};
+    split<case_type>(data, delim, out);
+    return out;
+}
+
+/**
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @param data The data to split by `delim`.
+ * @param delim The precompiled delimeter to split `data` by.
+ * @param out The string parts from the split.  This can be pre-allocated
+ *            for the expected number of items to split.
+ */
+template<case_t case_type>
+auto split(std::string_view data, const searcher<case_type>& delim, std::vector<std::string_view>& out) -> void;
+
+/**
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @param data The data to split by `delim`.
+ * @param delim The precompiled delimeter to split `data` by.
+ * @return The string parts from the split.
+ */
+template<case_t case_type>
+auto split(std::string_view data, const searcher<case_type>& delim) -> std::vector<std::string_view>
+{
+    std::vector<std::string_view> out{};
+    split(data, delim, out);
+    return out;
+}
+
+/**
+ * Splits `data` into a fixed number of parts, this can be evaluated at compile time, e.g.
+ * `constexpr auto parts = split<3>("GET /index.html HTTP/1.1", ' ');`.
+ * @tparam N The number of parts.  If `data` has more the last part is the rest of `data`
+ *           including its delimeters, if it has fewer the missing parts are empty.
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @param data The data to split by `delim`.
+ * @param delim The delimeter to split `data` by, an empty delimeter returns `data` as the first part.
+ * @return The string parts from the split.
+ */
+template<std::size_t N, case_t case_type = case_t::sensitive>
+constexpr auto split(std::string_view data, std::string_view delim) -> std::array<std::string_view, N>
+{
+    static_assert(N > 0, "split<N> requires at least one part");
+
+    return detail::instrumented(instrument::function::split, data.size(), [&]() {
+        std::array<std::string_view, N> out{};
+        if (delim.empty())
+        {
+            out[0] = data;
+            return out;
+        }
+
+        std::size_t start{0};
+        for (std::size_t i = 0; i + 1 < N; ++i)
+        {
+            const std::size_t next = find<case_type>(data, delim, start);
+            if (next == std::string_view::npos)
+            {
+                out[i] = data.substr(start);
+                return out;
+            }
+            out[i] = data.substr(start, next - start);
+            start  = next + delim.size();
+        }
+        out[N - 1] = data.substr(start);
+        return out;
+    });
+}
+
+/**
+ * Splits `data` into a fixed number of parts, this can be evaluated at compile time.
+ * @tparam N The number of parts, see the `std::string_view` delimeter overload.
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @param data The data to split by `delim`.
+ * @param delim The delimeter to split `data` by.
+ * @return The string parts from the split.
+ */
+template<std::size_t N, case_t case_type = case_t::sensitive>
+constexpr auto split(std::string_view data, char delim) -> std::array<std::string_view, N>
+{
+    return split<N, case_type>(data, std::string_view{&delim, 1});
+}
+
+/**
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @tparam T The output type that the `map_functor_type` maps into.
+ * @tparam map_functor_type The function type to apply against each split item.
+ * @param data The data to split by `delim`.
+ * @param delim The delimeter to split `data` by.
+ * @param map The map functor too apply to each split item.
+ * @param out The string parts from the split.  This can be pre-allocated
+ *            for the expected number of items to split.
+ */
+template<
+    typename T,
+    case_t case_type          = case_t::sensitive,
+    typename map_functor_type = std::function<T(std::string_view)>>
+auto split_map(std::string_view data, std::string_view delim, const map_functor_type& map, std::vector<T>& out) -> void
+{
+    std::size_t length;
+    std::size_t start = 0;
+
+    while (true)
+    {
+        std::size_t next = find<case_type>(data, delim, start);
+        if (next == std::string_view::npos)
+        {
+            // The length of this split is the full string length - start.
+            // This is also true if there were no delimiters found at all.
+            length = data.length() - start;
+            out.emplace_back(map(std::string_view{data.data() + start, length}));
+            break;
+        }
+
+        // The length of this split is from start to next.
+        length = next - start;
+        out.emplace_back(map(std::string_view{data.data() + start, length}));
+
+        // Update our iteration to skip the 'next' delimiter found.
+        start = next + delim.length();
+    }
+}
+
+/**
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @tparam T The output type that the `map_functor_type` maps into.
+ * @tparam map_functor_type The function type to apply against each split item.
+ * @param data The data to split by `delim`.
+ * @param delim The delimeter to split `data` by.
+ * @param map The map functor too apply to each split item.
+ * @param out The string parts from the split.  This can be pre-allocated
+ *            for the expected number of items to split.
+ */
+template<
+    typename T,
+    case_t case_type          = case_t::sensitive,
+    typename map_functor_type = std::function<T(std::string_view)>>
+auto split_map(std::string_view data, char delim, const map_functor_type& map, std::vector<T>& out) -> void
+{
+    detail::split_byte<case_type>(data, delim, [&](std::string_view part) { out.emplace_back(map(part)); });
+}
+
+/**
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @tparam T The output type that the `map_functor_type` maps into.
+ * @tparam map_functor_type The function type to apply against each split item.
+ * @param data The data to split by `delim`.
+ * @param delim The delimeter to split `data` by.
+ * @param map The map functor too apply to each split item.
+ * @return The string parts from the split.
+ */
+template<
+    typename T,
+    case_t case_type          = case_t::sensitive,
+    typename map_functor_type = std::function<T(std::string_view)>>
+auto split_map(std::string_view data, std::string_view delim, const map_functor_type& map) -> std::vector<T>
+{
+    std::vector<T> out{};
+    split_map<T, case_type, map_functor_type>(data, delim, map, out);
+    return out;
+}
+
+/**
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ * @tparam T The output type that the `map_functor_type` maps into.
+ * @tparam map_functor_type The function type to apply against each split item.
+ * @param data The data to split by `delim`.
+ * @param delim The delimeter to split `data` by.
+ * @param map The map functor too apply to each split item.
+ * @return The string parts from the split.
+ */
+template<
+    typename T                = std::string_view,
+    case_t case_type          = case_t::sensitive,
+    typename map_functor_type = std::function<T(std::string_view)>>
+auto split_map(std::string_view data, char delim, const map_functor_type& map) -> std::vector<T>
+{
+    std::vector<T> out{};
+    split_map<T, case_type, map_functor_type>(data, delim, map, out);
+    return out;
+}
+
+/**
+ * Splits the given data string by the given delimeter and calls a functor for each token.
+ * @tparam functor_type std::invocable<void(std::string_view)>
+ * @param data The string data to split by the given delimeter.
+ * @param delim The delimeter to split the data by.
+ * @param functor The functor to call for each tokenized part of the data.  By default this will
+ *                be called for every tokenized part of the data, if at some point stopping is
+ *                required then use a lambda or functor that returns a boolean.  After each token
+ *                part return true to continue parsing or false to break out of parsing.
+ */
+template<case_t case_type = case_t::sensitive, typename functor_type = std::function<void(std::string_view)>>
+auto split_for_each(std::string_view data, std::string_view delim, functor_type&& functor) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(split, data.size());
+    std::size_t length;
+    std::size_t start = 0;
+
+    while (true)
+    {
+        std::size_t next = find<case_type>(data, delim, start);
+        if (next == std::string_view::npos)
+        {
+            // The length of this split is the full string length - start.
+            // This is also true if there were no delimiters found at all.
+            length = data.length() - start;
+            functor(std::string_view{data.data() + start, length});
+            break;
+        }
+
+        // The length of this split is from start to next.
+        length = next - start;
+
+        if constexpr (std::is_same_v<std::invoke_result_t<functor_type, std::string_view>, bool>)
+        {
+            // Call the users functor for this token part, if they return false stop parsing.
+            if (!functor(std::string_view{data.data() + start, length}))
+            {
+                break;
+            }
+        }
+        else
+        {
+            functor(std::string_view{data.data() + start, length});
+        }
+
+        // Update our iteration to skip the 'next' delimiter found.
+        start = next + delim.length();
+    }
+}
+
+template<case_t case_type = case_t::sensitive, typename functor_type = std::function<bool(std::string_view)>>
+auto split_for_each(std::string_view data, char delim, functor_type&& functor) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(split, data.size());
+    detail::split_byte<case_type>(data, delim, std::forward<functor_type>(functor));
+}
+
+/**
+ * Splits the given data string by the given precompiled delimeter and calls a functor for each token.
+ * @tparam functor_type std::invocable<void(std::string_view)>
+ * @param data The string data to split by the given delimeter.
+ * @param delim The precompiled delimeter to split the data by.
+ * @param functor The functor to call for each tokenized part of the data, return false to stop
+ *                parsing early, see the `std::string_view` delimeter overload.
+ */
+template<case_t case_type, typename functor_type = std::function<void(std::string_view)>>
+auto split_for_each(std::string_view data, const searcher<case_type>& delim, functor_type&& functor) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(split, data.size());
+    std::size_t length;
+    std::size_t start = 0;
+
+    while (true)
+    {
+        std::size_t next = delim.find(data, start);
+        if (next == std::string_view::npos)
+        {
+            length = data.length() - start;
+            functor(std::string_view{data.data() + start, length});
+            break;
+        }
+
+        length = next - start;
+
+        if constexpr (std::is_same_v<std::invoke_result_t<functor_type, std::string_view>, bool>)
+        {
+            if (!functor(std::string_view{data.data() + start, length}))
+            {
+                break;
+            }
+        }
+        else
+        {
+            functor(std::string_view{data.data() + start, length});
+        }
+
+        start = next + delim.size();
+    }
+}
+
+template<case_t case_type>
+auto split(std::string_view data, const searcher<case_type>& delim, std::vector<std::string_view>& out) -> void
+{
+    split_for_each(data, delim, [&out](std::string_view part) { out.emplace_back(part); });
+}
+
+/**
+ * A lazy, non-allocating range over the parts of `data` split by a delimeter.  Each part is found
+ * as the range is iterated so stopping early skips the rest of the work, the parts are the same
+ * as `split()` would produce.  The view does not own `data` or a `std::string_view` delimeter.
+ * @tparam case_type Is the comparison case sensitive or insensitive?
+ */
+template<case_t case_type = case_t::sensitive>
+class split_view
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::string_view;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const std::string_view*;
+        using reference         = const std::string_view&;
+
+        iterator() : m_view(nullptr), m_part(), m_last(true) {}
+
+        auto operator*() const -> reference { return m_part; }
+        auto operator->() const -> pointer { return &m_part; }
+
+        auto operator++() -> iterator&
+        {
+            if (m_last)
+            {
+                // Past the final part, this is now the end iterator.
+                m_view = nullptr;
+            }
+            else
+            {
+                const auto offset = static_cast<std::size_t>(m_part.data() - m_view->m_data.data());
+                next(offset + m_part.size() + m_view->delim().size());
+            }
+            return *this;
+        }
+
+        auto operator++(int) -> iterator
+        {
+            iterator previous{*this};
+            ++(*this);
+            return previous;
+        }
+
+        friend auto operator==(const iterator& left, const iterator& right) -> bool
+        {
+            return left.m_view == right.m_view && (left.m_view == nullptr || left.m_part.data() == right.m_part.data());
+        }
+
+        friend auto operator!=(const iterator& left, const iterator& right) -> bool { return !(left == right); }
+
+    private:
+        friend class split_view;
+
+        explicit iterator(const split_view* view) : m_view(view), m_part(), m_last(false) { next(0); }
+
+        /// The view being iterated, null for the end iterator.
+        const split_view* m_view;
+        /// The current part.
+        std::string_view m_part;
+        /// True if the current part is the final one, no delimeter follows it.
+        bool m_last;
+
+        auto next(std::size_t start) -> void
+        {
+            const auto  delim = m_view->delim();
+            std::size_t found = delim.empty() ? std::string_view::npos : find<case_type>(m_view->m_data, delim, start);
+            if (found == std::string_view::npos)
+            {
+                found  = m_view->m_data.size();
+                m_last = true;
+            }
+            m_part = std::string_view{m_view->m_data.data() + start, found - start};
+        }
+    };
+
+    /**
+     * @param data The data to split by `delim`.
+     * @param delim The delimeter to split `data` by, an empty delimeter yields `data` as the only part.
+     */
+    split_view(std::string_view data, std::string_view delim)
+        : m_data(data),
+          m_delim(delim),
+          m_delim_char(),
+          m_is_char(false)
+    {
+    }
+
+    /**
+     * @param data The data to split by `delim`.
+     * @param delim The delimeter to split `data` by.
+     */
+    split_view(std::string_view data, char delim) : m_data(data), m_delim(), m_delim_char(delim), m_is_char(true) {}
+
+    auto begin() const -> iterator { return iterator{this}; }
+    auto end() const -> iterator { return iterator{}; }
+
+private:
+    std::string_view m_data;
+    std::string_view m_delim;
+    /// A char delimeter is stored by value so copies of the view remain valid.
+    char m_delim_char;
+    bool m_is_char;
+
+    auto delim() const -> std::string_view { return m_is_char ? std::string_view{&m_delim_char, 1} : m_delim; }
+};
+
+namespace detail
+{
+/// Values that are appended to a join as their characters.
+template<typename value_type>
+inline constexpr bool is_join_string_like_v = std::is_convertible_v<const value_type&, std::string_view>;
+
+/// Values that operator<< writes as a single character.
+template<typename value_type>
+inline constexpr bool is_join_char_v = std::is_same_v<value_type, char> || std::is_same_v<value_type, signed char> ||
+                                       std::is_same_v<value_type, unsigned char>;
+
+/// Integers std::to_chars formats, bool and the wide character types are left to operator<<.
+template<typename value_type>
+inline constexpr bool is_join_integer_v =
+    std::is_integral_v<value_type> && !is_join_char_v<value_type> && !std::is_same_v<value_type, bool> &&
+    !std::is_same_v<value_type, wchar_t> && !std::is_same_v<value_type, char16_t> &&
+    !std::is_same_v<value_type, char32_t>;
+
+/**
+ * A fixed capacity join output, bytes past the capacity are counted but not written so the
+ * required size is known after a truncated join.
+ */
+class join_buffer
+{
+public:
+    join_buffer(char* data, std::size_t capacity) : m_data(data), m_capacity(capacity), m_size(0) {}
+
+    auto append(const char* data, std::size_t length) -> void
+    {
+        if (m_size < m_capacity)
+        {
+            std::copy_n(data, std::min(length, m_capacity - m_size), m_data + m_size);
+        }
+        m_size += length;
+    }
+
+    auto push_back(char c) -> void
+    {
+        if (m_size < m_capacity)
+        {
+            m_data[m_size] = c;
+        }
+        ++m_size;
+    }
+
+    /// @return The number of bytes the join required, written or not.
+    auto size() const -> std::size_t { return m_size; }
+
+private:
+    char*       m_data;
+    std::size_t m_capacity;
+    std::size_t m_size;
+};
+
+/**
+ * Appends a single joined part to `out`, string like parts are copied directly, integers and
+ * floating point values are formatted with std::to_chars and anything else falls back to operator<<.
+ * Floating point values use the same `%g` precision 6 output as a default formatted stream.
+ * @tparam output_type std::string or join_buffer.
+ * @param out The output to append to.
+ * @param part The part to append.
+ */
+template<typename output_type, typename value_type>
+auto join_part(output_type& out, const value_type& part) -> void
+{
+    if constexpr (is_join_string_like_v<value_type>)
+    {
+        const std::string_view view{part};
+        out.append(view.data(), view.size());
+    }
+    else if constexpr (is_join_char_v<value_type>)
+    {
+        out.push_back(static_cast<char>(part));
+    }
+    else if constexpr (
+        is_join_integer_v<value_type> || (CHAIN_FLOAT_CHARCONV && std::is_floating_point_v<value_type>))
+    {
+        std::array<char, 64> buffer{};
+        std::to_chars_result result{};
+        if constexpr (std::is_floating_point_v<value_type>)
+        {
+            result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), part, std::chars_format::general, 6);
+        }
+        else
+        {
+            result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), part);
+        }
+        out.append(buffer.data(), static_cast<std::size_t>(result.ptr - buffer.data()));
+    }
+    else
+    {
+        thread_local std::stringstream ss{};
+
+        ss.clear();
+        ss.str("");
+        ss.copyfmt(g_ss_default_fmt);
+        ss << part;
+        const auto streamed = ss.str();
+        out.append(streamed.data(), streamed.size());
+    }
+}
+
+/// The map used by `join`, it lets `join_append` size string like parts without mapping them twice.
+struct join_identity
+{
+    template<typename value_type>
+    auto operator()(const value_type& part) const -> const value_type&
+    {
+        return part;
+    }
+};
+
+/**
+ * Appends each mapped part of `parts` separated by `delim` to `out`.  When the parts are string
+ * like and aren't mapped the output size is computed up front so `out` grows at most once.
+ * @tparam output_type std::string or join_buffer.
+ * @param out The output to append to.
+ * @param parts The set of values to join together with `delim`.
+ * @param delim The delimiter to place between each joined part.
+ * @param map Maps each part before it is appended.
+ */
+template<typename output_type, typename RangeType, typename map_functor_type>
+auto join_append(output_type& out, const RangeType& parts, std::string_view delim, const map_functor_type& map)
+    -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(join, 0);
+    [[maybe_unused]] const std::size_t start_size = out.size();
+
+    using part_type = std::decay_t<decltype(*std::begin(parts))>;
+
+    if constexpr (
+        std::is_same_v<output_type, std::string> && std::is_same_v<map_functor_type, join_identity> &&
+        is_join_string_like_v<part_type>)
+    {
+        std::size_t size{0};
+        std::size_t count{0};
+        for (const auto& part : parts)
+        {
+            size += std::string_view{part}.size();
+            ++count;
+        }
+        if (count > 1)
+        {
+            size += (count - 1) * delim.size();
+        }
+        out.reserve(out.size() + size);
+    }
+
+    bool first{true};
+    for (const auto& part : parts)
+    {
+        if (first)
+        {
+            first = false;
+        }
+        else
+        {
+            out.append(delim.data(), delim.size());
+        }
+
+        join_part(out, map(part));
+    }
+    CHAIN_INSTRUMENT_BYTES(out.size() - start_size);
+}
+} // namespace detail
+
+/**
+ * Joins a set of values together into a single string.  String like values are copied directly,
+ * arithmetic values are formatted with std::to_chars and any other values must have an ostream
+ * operator<< function declared to convert to strings.
+ * @tparam RangeType A container of values that can be converted into strings.
+ * @param parts The set of values to join together with `delim`.
+ * @param delim The delimter to place between each joined part.
+ * @return `parts` joined by `delim`.
+ */
+template<typename RangeType>
+auto join(const RangeType& parts, std::string_view delim) -> std::string
+{
+    std::string out{};
+    detail::join_append(out, parts, delim, detail::join_identity{});
+    return out;
+}
+
+/**
+ * Joins a set of values together into a single string.  String like values are copied directly,
+ * arithmetic values are formatted with std::to_chars and any other values must have an ostream
+ * operator<< function declared to convert to strings.
+ * @tparam RangeType A container of values that can be converted into strings.
+ * @param parts The set of values to join together with `delim`.
+ * @param delim The delimter to place between each joined part.
+ * @return `parts` joined by `delim`.
+ */
+template<typename RangeType>
+auto join(const RangeType& parts, char delim) -> std::string
+{
+    return join(parts, std::string_view{&delim, 1});
+}
+
+/**
+ * Maps and joins a set of values together into a single string.  The mapped values are
+ * converted to strings the same way as `join`.
+ * @tparam RangeType A container of values.
+ * @tparam map_functor_type A function to map each individual `parts` part before joining.
+ * @param parts The set of values to join together with `delim`.
+ * @param delim The delimter to place between each joined part.
+ * @return Mapped `parts` joined by `delim`.
+ */
+template<typename RangeType, typename map_functor_type>
+auto map_join(const RangeType& parts, std::string_view delim, const map_functor_type& map) -> std::string
+{
+    std::string out{};
+    detail::join_append(out, parts, delim, map);
+    return out;
+}
+
+/**
+ * Maps and joins a set of values together into a string.
+ * @tparam RangeType A container of values.
+ * @tparam map_functor_type A function to map each individual `parts` part before joining.
+ * @param parts The set of values to join together with `delim`.
+ * @param delim The delimter to place between each joined part.
+ * @return Mapped `parts` joined by `delim`.
+ */
+template<typename RangeType, typename map_functor_type>
+auto map_join(const RangeType& parts, char delim, const map_functor_type& map) -> std::string
+{
+    return map_join(parts, std::string_view{&delim, 1}, map);
+}
+
+/**
+ * Joins a set of values onto the end of `out`, reusing its capacity so a warmed up buffer joins
+ * without allocating.  Values are converted the same way as `join`.
+ * @tparam RangeType A container of values that can be converted into strings.
+ * @param out The string to append the joined `parts` to.
+ * @param parts The set of values to join together with `delim`.
+ * @param delim The delimter to place between each joined part.
+ */
+template<typename RangeType>
+auto join_into(std::string& out, const RangeType& parts, std::string_view delim) -> void
+{
+    detail::join_append(out, parts, delim, detail::join_identity{});
+}
+
+template<typename RangeType>
+auto join_into(std::string& out, const RangeType& parts, char delim) -> void
+{
+    join_into(out, parts, std::string_view{&delim, 1});
+}
+
+/**
+ * Joins a set of values into a caller owned buffer.  Values are converted the same way as `join`.
+ * @tparam RangeType A container of values that can be converted into strings.
+ * @param out The buffer to write the joined `parts` to, it is not null terminated.
+ * @param capacity The size of `out`, output past `capacity` is dropped.
+ * @param parts The set of values to join together with `delim`.
+ * @param delim The delimter to place between each joined part.
+ * @return The number of bytes the join requires, if this is larger than `capacity` only the
+ *         first `capacity` bytes were written.
+ */
+template<typename RangeType>
+auto join_into(char* out, std::size_t capacity, const RangeType& parts, std::string_view delim) -> std::size_t
+{
+    detail::join_buffer buffer{out, capacity};
+    detail::join_append(buffer, parts, delim, detail::join_identity{});
+    return buffer.size();
+}
+
+template<typename RangeType>
+auto join_into(char* out, std::size_t capacity, const RangeType& parts, char delim) -> std::size_t
+{
+    return join_into(out, capacity, parts, std::string_view{&delim, 1});
+}
+
+/**
+ * Maps and joins a set of values onto the end of `out`, see `join_into`.
+ * @tparam RangeType A container of values.
+ * @tparam map_functor_type A function to map each individual `parts` part before joining.
+ * @param out The string to append the mapped and joined `parts` to.
+ * @param parts The set of values to join together with `delim`.
+ * @param delim The delimter to place between each joined part.
+ */
+template<typename RangeType, typename map_functor_type>
+auto map_join_into(std::string& out, const RangeType& parts, std::string_view delim, const map_functor_type& map)
+    -> void
+{
+    detail::join_append(out, parts, delim, map);
+}
+
+template<typename RangeType, typename map_functor_type>
+auto map_join_into(std::string& out, const RangeType& parts, char delim, const map_functor_type& map) -> void
+{
+    map_join_into(out, parts, std::string_view{&delim, 1}, map);
+}
+
+/**
+ * Maps and joins a set of values into a caller owned buffer, see `join_into`.
+ * @tparam RangeType A container of values.
+ * @tparam map_functor_type A function to map each individual `parts` part before joining.
+ * @param out The buffer to write the joined `parts` to, it is not null terminated.
+ * @param capacity The size of `out`, output past `capacity` is dropped.
+ * @param parts The set of values to join together with `delim`.
+ * @param delim The delimter to place between each joined part.
+ * @return The number of bytes the join requires, if this is larger than `capacity` only the
+ *         first `capacity` bytes were written.
+ */
+template<typename RangeType, typename map_functor_type>
+auto map_join_into(
+    char* out, std::size_t capacity, const RangeType& parts, std::string_view delim, const map_functor_type& map)
+    -> std::size_t
+{
+    detail::join_buffer buffer{out, capacity};
+    detail::join_append(buffer, parts, delim, map);
+    return buffer.size();
+}
+
+template<typename RangeType, typename map_functor_type>
+auto map_join_into(char* out, std::size_t capacity, const RangeType& parts, char delim, const map_functor_type& map)
+    -> std::size_t
+{
+    return map_join_into(out, capacity, parts, std::string_view{&delim, 1}, map);
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data The data to see if it starts with `begin`.
+ * @param begin Value to check if `data` starts with.
+ * @return True if `data` starts with `begin`.  Equal length strings will match.
+ */
+template<case_t case_type = case_t::sensitive>
+constexpr auto starts_with(std::string_view data, std::string_view begin) -> bool
+{
+    return data.length() >= begin.length() && equal<case_type>(data.substr(0, begin.length()), begin);
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data The data to see if it ends with `begin`.
+ * @param begin Value to check if `data` ends with.
+ * @return True if `data` ends with `begin`.  Equal length strings will match.
+ */
+template<case_t case_type = case_t::sensitive>
+constexpr auto ends_with(std::string_view data, std::string_view end) -> bool
+{
+    return data.length() >= end.length() && equal<case_type>(data.substr(data.length() - end.length()), end);
+}
+
+/**
+ * Converts ASCII upper case letters to lower case, every other byte is copied unchanged.  This is
+ * locale independent and uses the active `simd_level`.
+ * @param data The data to transform to lower case.
+ * @param out Receives `data.size()` converted bytes, this may be `data.data()` to convert in place.
+ */
+auto to_lower_ascii(std::string_view data, char* out) -> void;
+
+/**
+ * Converts ASCII lower case letters to upper case, every other byte is copied unchanged.  This is
+ * locale independent and uses the active `simd_level`.
+ * @param data The data to transform to upper case.
+ * @param out Receives `data.size()` converted bytes, this may be `data.data()` to convert in place.
+ */
+auto to_upper_ascii(std::string_view data, char* out) -> void;
+
+/**
+ * @param data The data to transform to lower case.  ASCII only, uses the active `simd_level`.
+ */
+auto to_lower(std::string& data) -> void;
+
+/**
+ * @param data The data to transform to lower case.  ASCII only, uses the active `simd_level`.
+ * @return A copy of `data` transformed to lowercase.
+ */
+auto to_lower_copy(std::string_view data) -> std::string;
+
+/**
+ * @param data The data to transform to upper case.  ASCII only, uses the active `simd_level`.
+ */
+auto to_upper(std::string& data) -> void;
+
+/**
+ * @param data The data to transform to upper case.  ASCII only, uses the active `simd_level`.
+ * @return A copy of `data` transformed to uppercase.
+ */
+auto to_upper_copy(std::string_view data) -> std::string;
+
+/**
+ * @param data Trims the left side with "C" locale std::isspace() whitespace.
+ */
+auto trim_left(std::string& data) -> void;
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the left side of this data with `to_remove`.
+ * @param to_remove The value on the left side to remove from `data`.
+ */
+template<case_t case_type = case_t::sensitive>
+auto trim_left(std::string& data, std::string_view to_remove) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    if (!data.empty() && !to_remove.empty())
+    {
+        std::size_t      total_remove_size = 0;
+        std::string_view sv{data.data(), data.length()};
+        while (starts_with<case_type>(sv, to_remove))
+        {
+            sv.remove_prefix(to_remove.size());
+            total_remove_size += to_remove.size();
+        }
+
+        if (total_remove_size > 0)
+        {
+            data.erase(0, total_remove_size);
+        }
+    }
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the left side of this data with `to_remove`.
+ * @param to_remove The values on the left side to remove from `data`.
+ */
+template<case_t case_type = case_t::sensitive>
+auto trim_left(std::string& data, const std::vector<std::string_view>& to_remove) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    if (!data.empty() && !to_remove.empty())
+    {
+        std::size_t      total_remove_size = 0;
+        std::string_view sv{data.data(), data.length()};
+
+        while (true)
+        {
+            bool had_removal{false};
+
+            for (const auto& remove : to_remove)
+            {
+                while (starts_with<case_type>(sv, remove))
+                {
+                    sv.remove_prefix(remove.size());
+                    total_remove_size += remove.size();
+                    had_removal = true;
+                }
+            }
+
+            if (!had_removal)
+            {
+                break;
+            }
+        }
+
+        if (total_remove_size > 0)
+        {
+            data.erase(0, total_remove_size);
+        }
+    }
+}
+
+/**
+ * @param data Trims the left side of this data with "C" locale std::isspace() whitespace.
+ * @return A string view of `data` with the left side whitespace removed.
+ */
+constexpr auto trim_left_view(std::string_view data) -> std::string_view
+{
+    if (detail::is_constant_evaluated())
+    {
+        return data.substr(detail::constant::trim_left(data));
+    }
+    return detail::trim_left_view(data);
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the left side of this data with `to_remove`.
+ * @param to_remove The value on the left side to remove from `data`.
+ * @return A string view of `data` with the left side of `to_remove` removed.
+ */
+template<case_t case_type = case_t::sensitive>
+constexpr auto trim_left_view(std::string_view data, std::string_view to_remove) -> std::string_view
+{
+    return detail::instrumented(instrument::function::trim, data.size(), [&]() {
+        if (!data.empty() && !to_remove.empty())
+        {
+            while (starts_with<case_type>(data, to_remove))
+            {
+                data.remove_prefix(to_remove.size());
+            }
+        }
+
+        return data;
+    });
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the left side of this data with `to_remove`.
+ * @param to_remove The values on the left side to remove from `data`.
+ * @return A string view of `data` with the left side of `to_remove` removed.
+ */
+template<case_t case_type = case_t::sensitive>
+auto trim_left_view(std::string_view data, const std::vector<std::string_view>& to_remove) -> std::string_view
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    if (!data.empty() && !to_remove.empty())
+    {
+        while (true)
+        {
+            bool had_removal{false};
+
+            for (const auto& remove : to_remove)
+            {
+                while (starts_with<case_type>(data, remove))
+                {
+                    data.remove_prefix(remove.size());
+                    had_removal = true;
+                }
+            }
+
+            if (!had_removal)
+            {
+                break;
+            }
+        }
+    }
+
+    return data;
+}
+
+/**
+ * @param data Trims the right side with "C" locale std::isspace() whitespace.
+ */
+auto trim_right(std::string& data) -> void;
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the right side of this data with `to_remove`.
+ * @param to_remove The value on the right side to remove from `data`.
+ */
+template<case_t case_type = case_t::sensitive>
+auto trim_right(std::string& data, std::string_view to_remove) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    if (!to_remove.empty())
+    {
+        std::size_t      total_remove_size = 0;
+        std::string_view sv{data.data(), data.length()};
+        while (ends_with<case_type>(sv, to_remove))
+        {
+            sv.remove_suffix(to_remove.size());
+            total_remove_size += to_remove.size();
+        }
+        if (total_remove_size > 0)
+        {
+            data.erase(data.size() - total_remove_size);
+        }
+    }
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the right side of this data with `to_remove`.
+ * @param to_remove The values on the right side to remove from `data`.
+ */
+template<case_t case_type = case_t::sensitive>
+auto trim_right(std::string& data, const std::vector<std::string_view>& to_remove) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    if (!data.empty() && !to_remove.empty())
+    {
+        std::size_t      total_remove_size = 0;
+        std::string_view sv{data.data(), data.length()};
+
+        while (true)
+        {
+            bool had_removal{false};
+
+            for (const auto& remove : to_remove)
+            {
+                while (ends_with<case_type>(sv, remove))
+                {
+                    sv.remove_suffix(remove.size());
+                    total_remove_size += remove.size();
+                    had_removal = true;
+                }
+            }
+
+            if (!had_removal)
+            {
+                break;
+            }
+        }
+
+        if (total_remove_size > 0)
+        {
+            data.erase(data.size() - total_remove_size);
+        }
+    }
+}
+
+/**
+ * @param data Trims the right side of this data with "C" locale std::isspace() whitespace.
+ * @return A string view of `data` with the right side whitespace removed.
+ */
+constexpr auto trim_right_view(std::string_view data) -> std::string_view
+{
+    if (detail::is_constant_evaluated())
+    {
+        return data.substr(0, data.size() - detail::constant::trim_right(data));
+    }
+    return detail::trim_right_view(data);
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the right side of this data with `to_remove`.
+ * @param to_remove The value on the right side to remove from `data`.
+ * @return A string view of `data` with the right side of `to_remove` removed.
+ */
+template<case_t case_type = case_t::sensitive>
+constexpr auto trim_right_view(std::string_view data, std::string_view to_remove) -> std::string_view
+{
+    return detail::instrumented(instrument::function::trim, data.size(), [&]() {
+        if (!data.empty() && !to_remove.empty())
+        {
+            while (ends_with<case_type>(data, to_remove))
+            {
+                data.remove_suffix(to_remove.size());
+            }
+        }
+
+        return data;
+    });
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the right side of this data with `to_remove`.
+ * @param to_remove The values on the right side to remove from `data`.
+ * @return A string view of `data` with the right side of `to_remove` removed.
+ */
+template<case_t case_type = case_t::sensitive>
+auto trim_right_view(std::string_view data, const std::vector<std::string_view>& to_remove) -> std::string_view
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    if (!data.empty() && !to_remove.empty())
+    {
+        while (true)
+        {
+            bool had_removal{false};
+
+            for (const auto& remove : to_remove)
+            {
+                while (ends_with<case_type>(data, remove))
+                {
+                    data.remove_suffix(remove.size());
+                    had_removal = true;
+                }
+            }
+
+            if (!had_removal)
+            {
+                break;
+            }
+        }
+    }
+
+    return data;
+}
+
+/**
+ * @return Trims the left and right sides of `data` with "C" locale std::isspace() whitespace.
+ */
+auto trim(std::string& data) -> void;
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the left and right sides of this data with `to_remove`.
+ * @param to_remove The value on the left and right side to remove from `data`.
+ */
+template<case_t case_type = case_t::sensitive>
+auto trim(std::string& data, std::string_view to_remove) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    trim_left<case_type>(data, to_remove);
+    trim_right<case_type>(data, to_remove);
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the left and right sides of this data with `to_remove`.
+ * @param to_remove The values on the left and right side to remove from `data`.
+ */
+template<case_t case_type = case_t::sensitive>
+auto trim(std::string& data, const std::vector<std::string_view>& to_remove) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    trim_left<case_type>(data, to_remove);
+    trim_right<case_type>(data, to_remove);
+}
+
+/**
+ * @param data Trims the left and right sides of `data` with "C" locale std::isspace() whitespace.
+ * @return A string view of `data` with the left and right side whitespace removed.
+ */
+constexpr auto trim_view(std::string_view data) -> std::string_view
+{
+    if (detail::is_constant_evaluated())
+    {
+        data.remove_suffix(detail::constant::trim_right(data));
+        return data.substr(detail::constant::trim_left(data));
+    }
+    return detail::trim_view(data);
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the left and right side of this data with `to_remove`.
+ * @param to_remove The value on the left and right side to remove from `data`.
+ * @return A string view of `data` with the left and right side of `to_remove` removed.
+ */
+template<case_t case_type = case_t::sensitive>
+constexpr auto trim_view(std::string_view data, std::string_view to_remove) -> std::string_view
+{
+    return detail::instrumented(instrument::function::trim, data.size(), [&]() {
+        return trim_right_view<case_type>(trim_left_view<case_type>(data, to_remove), to_remove);
+    });
+}
+
+/**
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data Trims the left and right side of this data with `to_remove`.
+ * @param to_remove The values on the left and right side to remove from `data`.
+ * @return A string view of `data` with the left and right side of `to_remove` values removed.
+ */
+template<case_t case_type = case_t::sensitive>
+auto trim_view(std::string_view data, const std::vector<std::string_view>& to_remove) -> std::string_view
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    return trim_right_view<case_type>(trim_left_view<case_type>(data, to_remove), to_remove);
+}
+
+namespace detail
+{
+/// The most entries a thread local scratch vector keeps between calls, 32 KiB of offsets.
+inline constexpr std::size_t max_retained_scratch = 4096;
+
+/**
+ * Frees `scratch` if a large call grew it past `max_retained_scratch`, so one large input doesn't
+ * stay allocated for the rest of the thread's life.
+ */
+template<typename value_type>
+auto release_scratch(std::vector<value_type>& scratch) -> void
+{
+    if (scratch.capacity() > max_retained_scratch)
+    {
+        std::vector<value_type>{}.swap(scratch);
+    }
+}
+
+/**
+ * Replace engine shared by the raw and precompiled `replace` overloads.  Matches are located
+ * against the original `data` and every byte is moved at most once:
+ *   - If `to` isn't longer than `from` the output is compacted forward in place.
+ *   - Otherwise the matches are recorded in a reused thread local buffer, the final size is
+ *     computed and the output is either expanded backwards in place when `data` has the capacity,
+ *     or copied once into a new string.
+ * @param finder Callable `(std::string_view haystack, std::size_t pos) -> std::size_t` locating `from`.
+ * @param from_length The length of the value being replaced.
+ */
+template<typename finder_type>
+auto replace(
+    std::string&               data,
+    const finder_type&         finder,
+    std::size_t                from_length,
+    std::string_view           to,
+    std::optional<std::size_t> count) -> std::size_t
+{
+    CHAIN_INSTRUMENT_SCOPE(replace, data.size());
+    std::size_t replaced{0};
+
+    if (data.empty())
+    {
+        return replaced;
+    }
+
+    auto max = count.value_or(std::numeric_limits<std::size_t>::max());
+    if (max == 0)
+    {
+        return replaced; // 0 replacements asked for...!
+    }
+
+    const std::size_t size = data.size();
+    // An empty `from` matches before every character and at the end, step past each match.
+    const std::size_t step = std::max<std::size_t>(from_length, 1);
+
+    if (to.length() <= from_length)
+    {
+        // The output never overtakes the input so the unsearched tail is always intact.
+        char*       out = data.data();
+        std::size_t read{0};
+        std::size_t write{0};
+        std::size_t pos{0};
+        while (replaced < max && (pos = finder(std::string_view{data.data(), size}, pos)) != std::string_view::npos)
+        {
+            if (write != read)
+            {
+                std::copy(out + read, out + pos, out + write);
+            }
+            write += pos - read;
+            std::copy(to.begin(), to.end(), out + write);
+            write += to.length();
+
+            read = pos + from_length;
+            pos += step;
+            ++replaced;
+        }
+
+        if (replaced > 0)
+        {
+            std::copy(out + read, out + size, out + write);
+            data.resize(write + (size - read));
+        }
+        return replaced;
+    }
+
+    thread_local std::vector<std::size_t> matches{};
+    matches.clear();
+
+    std::size_t pos{0};
+    while (matches.size() < max && (pos = finder(data, pos)) != std::string_view::npos)
+    {
+        matches.push_back(pos);
+        pos += step;
+    }
+
+    replaced = matches.size();
+    if (replaced == 0)
+    {
+        return replaced;
+    }
+
+    const std::size_t final_size = size + replaced * (to.length() - from_length);
+
+    if (data.capacity() >= final_size)
+    {
+        // Expand backwards, the prefix before the first match doesn't move.
+        data.resize(final_size);
+        char*       out       = data.data();
+        std::size_t read_end  = size;
+        std::size_t write_end = final_size;
+        for (auto match = matches.rbegin(); match != matches.rend(); ++match)
+        {
+            const std::size_t tail = *match + from_length;
+            std::copy_backward(out + tail, out + read_end, out + write_end);
+            write_end -= read_end - tail;
+            write_end -= to.length();
+            std::copy(to.begin(), to.end(), out + write_end);
+            read_end = *match;
+        }
+    }
+    else
+    {
+        std::string output{};
+        output.reserve(final_size);
+        std::size_t read{0};
+        for (const auto match : matches)
+        {
+            output.append(data, read, match - read);
+            output.append(to.data(), to.length());
+            read = match + from_length;
+        }
+        output.append(data, read, std::string::npos);
+        data = std::move(output);
+    }
+
+    release_scratch(matches);
+    return replaced;
+}
+
+} // namespace detail
+
+/**
+ * Replaces up to `count` instances of `from` to `to` within `data`.
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data The data to replace instances of `from` with `to`.
+ * @param from The value to replace.
+ * @param to The value to replace with.
+ * @param count The maximum number of occurrences to replace, if std::nullopt all occurences are replaced.
+ * @return The number of `from` occurrences replaced with `to`.
+ */
+template<case_t case_type = case_t::sensitive>
+auto replace(
+    std::string& data, std::string_view from, std::string_view to, std::optional<std::size_t> count = std::nullopt)
+    -> std::size_t
+{
+    return detail::replace(
+        data,
+        [from](std::string_view haystack, std::size_t pos) { return find<case_type>(haystack, from, pos); },
+        from.length(),
+        to,
+        count);
+}
+
+/**
+ * Replaces up to `count` instances of the precompiled `from` to `to` within `data`.
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data The data to replace instances of `from` with `to`.
+ * @param from The precompiled value to replace.
+ * @param to The value to replace with.
+ * @param count The maximum number of occurrences to replace, if std::nullopt all occurences are replaced.
+ * @return The number of `from` occurrences replaced with `to`.
+ */
+template<case_t case_type>
+auto replace(
+    std::string&               data,
+    const searcher<case_type>& from,
+    std::string_view           to,
+    std::optional<std::size_t> count = std::nullopt) -> std::size_t
+{
+    return detail::replace(
+        data,
+        [&from](std::string_view haystack, std::size_t pos) { return from.find(haystack, pos); },
+        from.size(),
+        to,
+        count);
+}
+
+/**
+ * Replaces up to `count` instances of `from` to `to` within `data`.
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data The data to replace instances of `from` with `to`.
+ * @param from The value to replace.
+ * @param to The value to replace with.
+ * @param count The maximum number of occurrences to replace, if std::nullopt all occurences are replaced.
+ * @return `data` with replacements copy and the number of `from` occurrences replaced with `to`.
+ */
+template<case_t case_type = case_t::sensitive>
+auto replace_copy(
+    std::string data, std::string_view from, std::string_view to, std::optional<std::size_t> count = std::nullopt)
+    -> std::pair<std::string, std::size_t>
+{
+    std::size_t num = replace<case_type>(data, from, to, count);
+    return {std::move(data), num};
+}
+
+/**
+ * Replaces up to `count` instances of the precompiled `from` to `to` within `data`.
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data The data to replace instances of `from` with `to`.
+ * @param from The precompiled value to replace.
+ * @param to The value to replace with.
+ * @param count The maximum number of occurrences to replace, if std::nullopt all occurences are replaced.
+ * @return `data` with replacements copy and the number of `from` occurrences replaced with `to`.
+ */
+template<case_t case_type>
+auto replace_copy(
+    std::string                data,
+    const searcher<case_type>& from,
+    std::string_view           to,
+    std::optional<std::size_t> count = std::nullopt) -> std::pair<std::string, std::size_t>
+{
+    std::size_t num = replace(data, from, to, count);
+    return {std::move(data), num};
+}
+
+/**
+ * Replaces every precompiled `from` needle with its substitution in a single scan of `data`.
+ * Matches don't overlap and are chosen leftmost-longest, see `multi_searcher::find_leftmost_longest`,
+ * and the result is written in a single output pass.
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data The data to replace the needles in.
+ * @param from The precompiled needles to replace.
+ * @param to The substitution for each needle by index, it must have `from.size()` values.
+ * @throws std::invalid_argument If `to` doesn't have `from.size()` values, `data` is unchanged.
+ * @return The number of needles replaced.
+ */
+template<case_t case_type>
+auto replace_all(std::string& data, const multi_searcher<case_type>& from, const std::vector<std::string_view>& to)
+    -> std::size_t
+{
+    CHAIN_INSTRUMENT_SCOPE(replace_all, data.size());
+    if (to.size() != from.size())
     {
-        while (true)
-        {
-            bool had_removal{false};
+        throw std::invalid_argument{"replace_all requires a substitution for every needle"};
+    }
 
-            for (const auto& remove : to_remove)
-            {
-                while (starts_with<case_type>(data, remove))
-                {
-                    data.remove_prefix(remove.size());
-                    had_removal = true;
-                }
-            }
+    thread_local std::vector<multi_match> matches{};
+    matches.clear();
 
-            if (!had_removal)
-            {
-                break;
-            }
-        }
+    from.find_leftmost_longest(data, [](const multi_match& m) { matches.push_back(m); });
+    if (matches.empty())
+    {
+        return 0;
     }
 
-    return data;
+    std::size_t final_size = data.size();
+    for (const auto& m : matches)
+    {
+        final_size = final_size - m.length + to[m.pattern].length();
+    }
+
+    std::string output{};
+    output.reserve(final_size);
+    std::size_t read{0};
+    for (const auto& m : matches)
+    {
+        output.append(data, read, m.offset - read);
+        output.append(to[m.pattern].data(), to[m.pattern].length());
+        read = m.offset + m.length;
+    }
+    output.append(data, read, std::string::npos);
+    data = std::move(output);
+
+    const std::size_t replaced = matches.size();
+    detail::release_scratch(matches);
+    return replaced;
 }
 
 /**
- * @param data Trims the right side with std::isspace().
+ * Replaces every `from` with its `to` in a single scan of `data`, e.g.
+ * `replace_all(data, {{"&", "&amp;"}, {"<", "&lt;"}, {">", "&gt;"}})`.  Matches don't overlap and
+ * are chosen leftmost-longest, the first pair wins between equal `from` values.  To replace the
+ * same set repeatedly precompile it into a `multi_searcher`.
+ * @tparam case_type Use case insensitive or senstive equality checks.
+ * @param data The data to replace the `from` values in.
+ * @param replacements The `{from, to}` pairs, empty `from` values never match.
+ * @return The number of values replaced.
  */
-auto trim_right(std::string& data) -> void;
+template<case_t case_type = case_t::sensitive>
+auto replace_all(std::string& data, const std::vector<std::pair<std::string_view, std::string_view>>& replacements)
+    -> std::size_t
+{
+    CHAIN_INSTRUMENT_SCOPE(replace_all, data.size());
+    std::vector<std::string_view> from{};
+    std::vector<std::string_view> to{};
+    from.reserve(replacements.size());
+    to.reserve(replacements.size());
+    for (const auto& [f, t] : replacements)
+    {
+        from.push_back(f);
+        to.push_back(t);
+    }
+
+    return replace_all(data, multi_searcher<case_type>{from}, to);
+}
 
 /**
+ * Replaces every `from` with its `to` in a single scan of a copy of `data`, see `replace_all`.
  * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the right side of this data with `to_remove`.
- * @param to_remove The value on the right side to remove from `data`.
+ * @param data The data to replace the `from` values in.
+ * @param replacements The `{from, to}` pairs, empty `from` values never match.
+ * @return `data` with replacements copy and the number of values replaced.
  */
 template<case_t case_type = case_t::sensitive>
-auto trim_right(std::string& data, std::string_view to_remove) -> void
+auto replace_all_copy(
+    std::string data, const std::vector<std::pair<std::string_view, std::string_view>>& replacements)
+    -> std::pair<std::string, std::size_t>
 {
-    if (!to_remove.empty())
-    {
-        std::size_t      total_remove_size = 0;
-        std::string_view sv{data.data(), data.length()};
-        while (ends_with<case_type>(sv, to_remove))
-        {
-            sv.remove_suffix(to_remove.size());
-            total_remove_size += to_remove.size();
-        }
-        if (total_remove_size > 0)
-        {
-            data.erase(data.size() - total_remove_size);
-        }
-    }
+    std::size_t num = replace_all<case_type>(data, replacements);
+    return {std::move(data), num};
 }
 
 /**
+ * Replaces every `from` with `to` in a stream of chunks, e.g. a file or socket read 64 KiB at a
+ * time, with the same non-overlapping results as `replace` over the whole input.  Only the last
+ * `from.size() - 1` bytes of a chunk are held back to complete matches straddling the next one
+ * so memory stays bounded regardless of the input size.
+ *
+ * The output is passed to a sink `void(std::string_view)` in order, the views are only valid
+ * for the duration of the sink call.
  * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the right side of this data with `to_remove`.
- * @param to_remove The values on the right side to remove from `data`.
  */
 template<case_t case_type = case_t::sensitive>
-auto trim_right(std::string& data, const std::vector<std::string_view>& to_remove) -> void
+class stream_replacer
 {
-    if (!data.empty() && !to_remove.empty())
+public:
+    /**
+     * @param from The value to replace, an empty value passes the stream through unchanged.
+     * @param to The value to replace with.
+     */
+    stream_replacer(std::string_view from, std::string_view to) : m_from(from), m_to(to), m_carry(), m_replaced(0)
     {
-        std::size_t      total_remove_size = 0;
-        std::string_view sv{data.data(), data.length()};
+        m_carry.reserve(2 * m_from.size());
+    }
 
-        while (true)
+    /**
+     * Replaces `from` in the next chunk of the stream.
+     * @tparam sink_type std::invocable<void(std::string_view)>
+     * @param chunk The next chunk of input, it is not referenced after this call returns.
+     * @param sink Receives the output that is complete so far.
+     */
+    template<typename sink_type>
+    auto write(std::string_view chunk, sink_type&& sink) -> void
+    {
+        const std::size_t n = m_from.size();
+        if (n == 0)
         {
-            bool had_removal{false};
+            emit(chunk, sink);
+            return;
+        }
 
-            for (const auto& remove : to_remove)
+        if (!m_carry.empty())
+        {
+            // Join the carry with enough of the chunk to complete any match starting in the carry.
+            const std::size_t carried = m_carry.size();
+            const std::size_t take    = std::min(n - 1, chunk.size());
+            m_carry.append(chunk.data(), take);
+
+            if (take < chunk.size())
             {
-                while (ends_with<case_type>(sv, remove))
+                const std::size_t last = scan(m_carry, sink);
+                if (last < carried)
                 {
-                    sv.remove_suffix(remove.size());
-                    total_remove_size += remove.size();
-                    had_removal = true;
+                    emit(std::string_view{m_carry}.substr(last, carried - last), sink);
                 }
+                const std::size_t start = std::max(last, carried) - carried;
+                m_carry.clear();
+                carry(chunk, start, sink);
+                return;
             }
 
-            if (!had_removal)
-            {
-                break;
-            }
+            // The whole chunk fit, the joined buffer is all the input there is so far.
+            const std::size_t last = scan(m_carry, sink);
+            const std::size_t keep = std::min(n - 1, m_carry.size() - last);
+            emit(std::string_view{m_carry}.substr(last, m_carry.size() - last - keep), sink);
+            m_carry.erase(0, m_carry.size() - keep);
+            return;
         }
 
-        if (total_remove_size > 0)
+        carry(chunk, 0, sink);
+    }
+
+    /**
+     * Ends the stream, the held back bytes can no longer start a match and are emitted.  The
+     * replacer can then be reused for a new stream.
+     * @tparam sink_type std::invocable<void(std::string_view)>
+     * @param sink Receives the remaining output.
+     */
+    template<typename sink_type>
+    auto finish(sink_type&& sink) -> void
+    {
+        emit(m_carry, sink);
+        m_carry.clear();
+    }
+
+    /**
+     * @return The number of `from` occurrences replaced so far, across streams.
+     */
+    auto replaced() const -> std::size_t { return m_replaced; }
+
+private:
+    /// The value to replace.
+    searcher<case_type> m_from;
+    /// The value to replace with.
+    std::string m_to;
+    /// Bytes held back from the previous chunk that may begin a match, fewer than `m_from.size()`.
+    std::string m_carry;
+    /// The number of replacements made.
+    std::size_t m_replaced;
+
+    template<typename sink_type>
+    static auto emit(std::string_view data, sink_type& sink) -> void
+    {
+        if (!data.empty())
         {
-            data.erase(data.size() - total_remove_size);
+            sink(data);
         }
     }
-}
 
+    /**
+     * Replaces every complete match in `data`.
+     * @return The offset after the last match, everything before it has been emitted.
+     */
+    template<typename sink_type>
+    auto scan(std::string_view data, sink_type& sink) -> std::size_t
+    {
+        std::size_t last{0};
+        std::size_t pos{0};
+        while ((pos = m_from.find(data, last)) != std::string_view::npos)
+        {
+            emit(data.substr(last, pos - last), sink);
+            emit(m_to, sink);
+            last = pos + m_from.size();
+            ++m_replaced;
+        }
+        return last;
+    }
+
+    /**
+     * Replaces every complete match in `data` from `start` and holds back the tail that could
+     * begin a match in the next chunk.
+     */
+    template<typename sink_type>
+    auto carry(std::string_view data, std::size_t start, sink_type& sink) -> void
+    {
+        data.remove_prefix(start);
+
+        const std::size_t last = scan(data, sink);
+        const std::size_t keep = std::min(m_from.size() - 1, data.size() - last);
+        emit(data.substr(last, data.size() - last - keep), sink);
+        m_carry.assign(data.data() + data.size() - keep, keep);
+    }
+};
+
+namespace detail
+{
 /**
- * @param data Trims the right side of this data with `to_remove`.
- * @return A string view of `data` with the right side of `to_remove` removed.
+ * The `trim()` step of a `pipeline`, removes leading and trailing "C" locale whitespace from the
+ * stream.  Whitespace at the end of a chunk is held back until more data shows it isn't trailing.
  */
-auto trim_right_view(std::string_view data) -> std::string_view;
+class trim_stage
+{
+public:
+    template<typename sink_type>
+    auto write(std::string_view chunk, sink_type&& sink) -> void
+    {
+        if (m_leading)
+        {
+            chunk = trim_left_view(chunk);
+            if (chunk.empty())
+            {
+                return;
+            }
+            m_leading = false;
+        }
+
+        const auto body = trim_right_view(chunk);
+        if (body.empty())
+        {
+            m_pending.append(chunk.data(), chunk.size());
+            return;
+        }
+
+        if (!m_pending.empty())
+        {
+            sink(std::string_view{m_pending});
+            m_pending.clear();
+        }
+        sink(body);
+        m_pending.assign(chunk.data() + body.size(), chunk.size() - body.size());
+    }
+
+    template<typename sink_type>
+    auto finish(sink_type&&) -> void
+    {
+        m_leading = true;
+        m_pending.clear();
+    }
+
+private:
+    /// True until the first non whitespace byte.
+    bool m_leading{true};
+    /// Whitespace that is trailing unless more non whitespace follows.
+    std::string m_pending{};
+};
 
 /**
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the right side of this data with `to_remove`.
- * @param to_remove The value on the right side to remove from `data`.
- * @return A string view of `data` with the right side of `to_remove` removed.
+ * The `lower()` and `upper()` steps of a `pipeline`, converts the stream a block at a time
+ * through a stack buffer with the active `simd_level`.
  */
-template<case_t case_type = case_t::sensitive>
-auto trim_right_view(std::string_view data, std::string_view to_remove) -> std::string_view
+template<bool to_upper_case>
+class case_stage
 {
-    if (!data.empty() && !to_remove.empty())
+public:
+    template<typename sink_type>
+    auto write(std::string_view chunk, sink_type&& sink) -> void
     {
-        while (ends_with<case_type>(data, to_remove))
+        std::array<char, 4096> buffer;
+        while (!chunk.empty())
         {
-            data.remove_suffix(to_remove.size());
+            const auto part = chunk.substr(0, buffer.size());
+            if constexpr (to_upper_case)
+            {
+                to_upper_ascii(part, buffer.data());
+            }
+            else
+            {
+                to_lower_ascii(part, buffer.data());
+            }
+            sink(std::string_view{buffer.data(), part.size()});
+            chunk.remove_prefix(part.size());
         }
     }
 
-    return data;
-}
+    template<typename sink_type>
+    auto finish(sink_type&&) -> void
+    {
+    }
+};
+} // namespace detail
 
 /**
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the right side of this data with `to_remove`.
- * @param to_remove The values on the right side to remove from `data`.
- * @return A string view of `data` with the right side of `to_remove` removed.
+ * A lazy sequence of transformations over `data`, see `chain()`.  The steps are only recorded
+ * in the pipeline's type as it is built, running it streams `data` through every step in one
+ * pass, each step passing its output to the next as it is produced.  The steps give the same
+ * result as applying `trim`, `to_lower`, `to_upper` and `replace` to the whole string in order.
+ *
+ * The building functions consume the pipeline, e.g. `std::move(p).lower()`.  A pipeline can be
+ * run any number of times, it doesn't own `data`.
+ * @tparam stages The steps in order, each has the `write` and `finish` of `stream_replacer`.
  */
-template<case_t case_type = case_t::sensitive>
-auto trim_right_view(std::string_view data, const std::vector<std::string_view>& to_remove) -> std::string_view
+template<typename... stages>
+class pipeline
 {
-    if (!data.empty() && !to_remove.empty())
+public:
+    pipeline(std::string_view data, std::tuple<stages...> steps)
+        : m_data(data),
+          m_stages(std::move(steps)),
+          m_straddling(),
+          m_output(),
+          m_stopped(false)
     {
-        while (true)
+    }
+
+    /**
+     * Adds a step that removes leading and trailing "C" locale whitespace.
+     */
+    auto trim() && -> pipeline<stages..., detail::trim_stage> { return std::move(*this).then(detail::trim_stage{}); }
+
+    /**
+     * Adds a step that converts ASCII to lower case.
+     */
+    auto lower() && -> pipeline<stages..., detail::case_stage<false>>
+    {
+        return std::move(*this).then(detail::case_stage<false>{});
+    }
+
+    /**
+     * Adds a step that converts ASCII to upper case.
+     */
+    auto upper() && -> pipeline<stages..., detail::case_stage<true>>
+    {
+        return std::move(*this).then(detail::case_stage<true>{});
+    }
+
+    /**
+     * Adds a step that replaces every `from` with `to`.
+     * @tparam case_type Use case insensitive or senstive equality checks.
+     * @param from The value to replace, copied into the pipeline.
+     * @param to The value to replace with, copied into the pipeline.
+     */
+    template<case_t case_type = case_t::sensitive>
+    auto replace(std::string_view from, std::string_view to) && -> pipeline<stages..., stream_replacer<case_type>>
+    {
+        return std::move(*this).then(stream_replacer<case_type>{from, to});
+    }
+
+    /**
+     * Runs the pipeline without collecting the output.
+     * @tparam sink_type std::invocable<void(std::string_view)>
+     * @param sink Receives the output in order, the views are only valid for the duration of the call.
+     */
+    template<typename sink_type>
+    auto for_each(sink_type&& sink) -> void
+    {
+        run(sink, m_data.size());
+    }
+
+    /**
+     * Runs the pipeline.
+     * @param out The output is appended to this string.
+     */
+    auto into(std::string& out) -> void
+    {
+        out.reserve(out.size() + m_data.size());
+        for_each([&out](std::string_view part) { out.append(part.data(), part.size()); });
+    }
+
+    /**
+     * Runs the pipeline.
+     * @return The output, the only buffer the pipeline allocates.
+     */
+    auto str() -> std::string
+    {
+        std::string out{};
+        into(out);
+        return out;
+    }
+
+    /**
+     * Runs the pipeline and splits the output by `delim` as it is produced, a 4 KiB block at a
+     * time.  Only parts that straddle blocks are copied, into a buffer kept for the next run.
+     * When `functor` stops early the steps stop too, after at most the 4 KiB block of `data`
+     * they're processing.
+     * @tparam functor_type std::invocable<void(std::string_view)>, return false to stop early.
+     * @param delim The delimeter to split the output by.
+     * @param functor Called for each part, the views are only valid for the duration of the call.
+     */
+    template<typename functor_type>
+    auto split_for_each(char delim, functor_type&& functor) -> void
+    {
+        constexpr bool can_stop = std::is_same_v<std::invoke_result_t<functor_type, std::string_view>, bool>;
+
+        m_straddling.clear();
+        auto call = [&](std::string_view part) {
+            if constexpr (can_stop)
+            {
+                m_stopped = !functor(part);
+            }
+            else
+            {
+                functor(part);
+            }
+        };
+
+        auto split_chunk = [&](std::string_view chunk) {
+            detail::split_byte<case_t::sensitive>(chunk, delim, [&](std::string_view part) {
+                if (part.data() + part.size() == chunk.data() + chunk.size())
+                {
+                    // The final part of the chunk continues in the next one.
+                    m_straddling.append(part.data(), part.size());
+                }
+                else if (m_straddling.empty())
+                {
+                    call(part);
+                }
+                else
+                {
+                    m_straddling.append(part.data(), part.size());
+                    call(m_straddling);
+                    m_straddling.clear();
+                }
+                return !m_stopped;
+            });
+        };
+
+        // Steps like replace produce many small chunks, they're gathered so the delimeters are
+        // found a block at a time.
+        std::array<char, 4096> block;
+        std::size_t            used{0};
+
+        auto gather = [&](std::string_view chunk) {
+            if (used + chunk.size() > block.size() && used > 0 && !m_stopped)
+            {
+                split_chunk(std::string_view{block.data(), used});
+                used = 0;
+            }
+            if (m_stopped)
+            {
+                return;
+            }
+            if (chunk.size() < block.size())
+            {
+                std::memcpy(block.data() + used, chunk.data(), chunk.size());
+                used += chunk.size();
+            }
+            else
+            {
+                split_chunk(chunk);
+            }
+        };
+        // Only a functor that can stop needs `data` fed to the steps a block at a time.
+        run(gather, can_stop ? block.size() : m_data.size());
+
+        if (!m_stopped && used > 0)
+        {
+            split_chunk(std::string_view{block.data(), used});
+        }
+
+        if (!m_stopped)
+        {
+            call(m_straddling);
+        }
+        m_stopped = false;
+    }
+
+    /**
+     * Runs the pipeline into a buffer it keeps for the next run and splits it by `delim`.
+     * @param delim The delimeter to split the output by.
+     * @return Each part of the output, the views are valid until the pipeline is run again or destroyed.
+     */
+    auto split(char delim) & -> std::vector<std::string_view>
+    {
+        m_output.clear();
+        into(m_output);
+        return chain::str::split(m_output, delim);
+    }
+
+    /**
+     * Runs a temporary pipeline and splits the output by `delim`, e.g.
+     * `auto parts = chain(data).trim().split(',')`.
+     * @param delim The delimeter to split the output by.
+     * @return A copy of each part of the output, views into the pipeline wouldn't outlive it.
+     */
+    auto split(char delim) && -> std::vector<std::string>
+    {
+        std::vector<std::string> out{};
+        split_for_each(delim, [&out](std::string_view part) { out.emplace_back(part); });
+        return out;
+    }
+
+private:
+    /// The input of every run.
+    std::string_view m_data;
+    /// The steps in order.
+    std::tuple<stages...> m_stages;
+    /// The part of the output being split that started in an earlier chunk.
+    std::string m_straddling;
+    /// The output `split` returns views into.
+    std::string m_output;
+    /// Set when the sink stops early, the steps drop their output from then on.
+    bool m_stopped;
+
+    template<typename stage_type>
+    auto then(stage_type stage) && -> pipeline<stages..., stage_type>
+    {
+        return pipeline<stages..., stage_type>{
+            m_data, std::tuple_cat(std::move(m_stages), std::make_tuple(std::move(stage)))};
+    }
+
+    /**
+     * Streams `data` through the steps `slice` bytes at a time, until it ends or the sink stops.
+     */
+    template<typename sink_type>
+    auto run(sink_type& sink, std::size_t slice) -> void
+    {
+        for (std::size_t offset = 0; offset < m_data.size() && !m_stopped; offset += slice)
+        {
+            write<0>(m_data.substr(offset, slice), sink);
+        }
+        finish<0>(sink);
+    }
+
+    /**
+     * Passes `chunk` through the steps from `i` to the sink.
+     */
+    template<std::size_t i, typename sink_type>
+    auto write(std::string_view chunk, sink_type& sink) -> void
+    {
+        if (m_stopped)
         {
-            bool had_removal{false};
-
-            for (const auto& remove : to_remove)
+            return;
+        }
+        if constexpr (i == sizeof...(stages))
+        {
+            if (!chunk.empty())
             {
-                while (ends_with<case_type>(data, remove))
-                {
-                    data.remove_suffix(remove.size());
-                    had_removal = true;
-                }
+                sink(chunk);
             }
+        }
+        else
+        {
+            std::get<i>(m_stages).write(chunk, [this, &sink](std::string_view out) { write<i + 1>(out, sink); });
+        }
+    }
 
-            if (!had_removal)
-            {
-                break;
-            }
+    /**
+     * Ends the stream at each step from `i` in order, each step's held back output goes through the rest.
+     */
+    template<std::size_t i, typename sink_type>
+    auto finish(sink_type& sink) -> void
+    {
+        if constexpr (i < sizeof...(stages))
+        {
+            std::get<i>(m_stages).finish([this, &sink](std::string_view out) { write<i + 1>(out, sink); });
+            finish<i + 1>(sink);
         }
     }
+};
 
-    return data;
+/**
+ * Starts a lazy pipeline over `data`, e.g. `chain(data).trim().lower().replace("a", "b").split(',')`
+ * runs every step in a single pass over `data` instead of a pass and a copy per step.
+ * @param data The input, it must outlive the pipeline.
+ * @return A pipeline without any steps.
+ */
+inline auto chain(std::string_view data) -> pipeline<>
+{
+    return pipeline<>{data, std::tuple<>{}};
 }
 
 /**
- * @return Trims the left and right sides of `data` with std::isspace().
+ * The lexical form of a number, see `classify_number`.
  */
-auto trim(std::string& data) -> void;
+enum class number_class
+{
+    /// Doesn't start with a number.
+    invalid,
+    /// Decimal digits, e.g. "-42".
+    integer,
+    /// Digits with a fraction, infinity or NaN, e.g. "4.2", ".5", "0x1.8", "inf" or "nan".
+    floating,
+    /// "0x" or "0X" followed by hexadecimal digits, e.g. "0x2A".
+    hex,
+    /// An integer or fraction with an exponent, e.g. "4.2e-1" or "0x1p4".
+    exponent
+};
 
 /**
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the left and right sides of this data with `to_remove`.
- * @param to_remove The value on the left and right side to remove from `data`.
+ * The result of `classify_number`.
  */
-template<case_t case_type = case_t::sensitive>
-auto trim(std::string& data, std::string_view to_remove) -> void
+struct number_classification
 {
-    trim_left<case_type>(data, to_remove);
-    trim_right<case_type>(data, to_remove);
-}
+    /// The form of the number `data` starts with.
+    number_class kind{number_class::invalid};
+    /// The number of characters from the start of `data` to the end of the number, including
+    /// leading whitespace and its sign.
+    std::size_t length{0};
+};
 
 /**
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the left and right sides of this data with `to_remove`.
- * @param to_remove The values on the left and right side to remove from `data`.
+ * Classifies the number `data` starts with in a single pass, without allocating or converting it.
+ * Accepts what `to_number` parses for floating point types: leading ASCII whitespace and an
+ * optional '+' or '-' may precede the number, "inf", "infinity" and "nan" are matched case
+ * insensitively and a hexadecimal number may have a fraction and a 'p' exponent.  An exponent or
+ * hexadecimal prefix that isn't followed by digits isn't part of the number, e.g. "1e" is an
+ * integer of length 1.
+ * @param data The data to classify.
+ * @return The form and length of the number `data` starts with.
  */
-template<case_t case_type = case_t::sensitive>
-auto trim(std::string& data, const std::vector<std::string_view>& to_remove) -> void
-{
-    trim_left<case_type>(data, to_remove);
-    trim_right<case_type>(data, to_remove);
-}
+auto classify_number(std::string_view data) -> number_classification;
 
 /**
- * @param data Trims the left and right sides of `data` with std::isspace().
- * @return A string view of `data` with the left and right side of `to_remove` removed.
+ * @param data Determines if `data` is an integer.
+ * @return True if `data` starts with a decimal integer, without leading whitespace, the same as
+ *         `to_number` parses for integer types.
  */
-auto trim_view(std::string_view data) -> std::string_view;
+auto is_int(std::string_view data) -> bool;
 
 /**
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the left and right side of this data with `to_remove`.
- * @param to_remove The value on the left and right side to remove from `data`.
- * @return A string view of `data` with the left and right side of `to_remove` removed.
+ * @param data Determines if `data` is floating point.
+ * @return True if `data` starts with a fraction, a number with an exponent, infinity or NaN.
  */
-template<case_t case_type = case_t::sensitive>
-auto trim_view(std::string_view data, std::string_view to_remove) -> std::string_view
+auto is_float(std::string_view data) -> bool;
+
+/**
+ * @param data Determines if `data` is an number.
+ * @return True if `data` starts with any form of number.
+ */
+auto is_number(std::string_view data) -> bool;
+
+namespace detail
 {
-    return trim_right_view<case_type>(trim_left_view<case_type>(data, to_remove), to_remove);
+/// The most digits `parse_decimal_digits` accumulates, 19 decimal digits always fit in a uint64_t.
+inline constexpr std::size_t max_decimal_digits = 19;
+
+/**
+ * @param word 8 bytes, the first in the lowest byte.
+ * @return True if every byte of `word` is an ASCII digit.
+ */
+inline auto swar_all_digits(uint64_t word) -> bool
+{
+    return ((word & 0xF0F0F0F0F0F0F0F0ULL) | (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+           0x3333333333333333ULL;
 }
 
 /**
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data Trims the left and right side of this data with `to_remove`.
- * @param to_remove The values on the left and right side to remove from `data`.
- * @return A string view of `data` with the left and right side of `to_remove` values removed.
+ * Converts 8 ASCII digits to their value with three multiplies, pairs of digits are combined,
+ * then pairs of pairs and finally the two 4 digit halves.
+ * @param word 8 ASCII digits, the most significant in the lowest byte.
+ * @return The value of the digits.
  */
-template<case_t case_type = case_t::sensitive>
-auto trim_view(std::string_view data, const std::vector<std::string_view>& to_remove) -> std::string_view
+inline auto swar_parse_eight(uint64_t word) -> uint64_t
 {
-    return trim_right_view<case_type>(trim_left_view<case_type>(data, to_remove), to_remove);
+    constexpr uint64_t mask = 0x000000FF000000FFULL;
+    constexpr uint64_t mul1 = 100 + (1000000ULL << 32);
+    constexpr uint64_t mul2 = 1 + (10000ULL << 32);
+
+    word -= 0x3030303030303030ULL;
+    word = (word * 10) + (word >> 8);
+    return (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
 }
 
 /**
- * Replaces up to `count` instances of `from` to `to` within `data`.
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data The data to replace instances of `from` with `to`.
- * @param from The value to replace.
- * @param to The value to replace with.
- * @param count The maximum number of occurrences to replace, if std::nullopt all occurences are replaced.
- * @return The number of `from` occurrences replaced with `to`.
+ * Parses the leading run of ASCII decimal digits, 8 at a time while they last.
+ * @param data The characters to parse.
+ * @param size The number of characters in `data`.
+ * @param value The value of the digits, only valid if the return is at most `max_decimal_digits`.
+ * @return The number of leading digits, or `max_decimal_digits + 1` if there are more.
  */
-template<case_t case_type = case_t::sensitive>
-auto replace(
-    std::string& data, std::string_view from, std::string_view to, std::optional<std::size_t> count = std::nullopt)
-    -> std::size_t
+inline auto parse_decimal_digits(const char* data, std::size_t size, uint64_t& value) -> std::size_t
 {
-    std::size_t replaced{0};
+    value         = 0;
+    std::size_t i = 0;
 
-    if (!data.empty())
+#if CHAIN_LITTLE_ENDIAN
+    // At most two words so the scalar loop can finish up to `max_decimal_digits` without overflow.
+    for (; i + 8 <= size && i < 16; i += 8)
     {
-        auto max = count.value_or(std::numeric_limits<std::size_t>::max());
-        if (max == 0)
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if (!swar_all_digits(word))
         {
-            return replaced; // 0 replacements asked for...!
+            break;
         }
+        value = value * 100000000 + swar_parse_eight(word);
+    }
+#endif
 
-        std::size_t pos{0};
-        while ((pos = find<case_type>(data, from, pos)) != std::string_view::npos)
+    for (; i < size && static_cast<unsigned char>(data[i] - '0') < 10; ++i)
+    {
+        if (i == max_decimal_digits)
         {
-            data.replace(pos, from.length(), to.data(), to.length());
-            pos += to.length();
-            ++replaced;
-
-            if (replaced >= max)
-            {
-                break; // while()
-            }
+            return i + 1;
         }
+        value = value * 10 + static_cast<uint64_t>(data[i] - '0');
     }
-
-    return replaced;
-}
-
-/**
- * Replaces up to `count` instances of `from` to `to` within `data`.
- * @tparam case_type Use case insensitive or senstive equality checks.
- * @param data The data to replace instances of `from` with `to`.
- * @param from The value to replace.
- * @param to The value to replace with.
- * @param count The maximum number of occurrences to replace, if std::nullopt all occurences are replaced.
- * @return `data` with replacements copy and the number of `from` occurrences replaced with `to`.
- */
-template<case_t case_type = case_t::sensitive>
-auto replace_copy(
-    std::string data, std::string_view from, std::string_view to, std::optional<std::size_t> count = std::nullopt)
-    -> std::pair<std::string, std::size_t>
-{
-    std::size_t num = replace<case_type>(data, from, to, count);
-    return {std::move(data), num};
+    return i;
 }
 
 /**
- * @param data Determines if `data` is an integer.
- * @return True if `data` starts with an integer value.
- */
-auto is_int(std::string_view data) -> bool;
-
-/**
- * @note This currently requires taking a copy of `data` to meet the floating point
- *       to_number limitations.
- *
- * @param data Determines if `data` is floating point.
- * @return True if `data` starts with an integer value.
+ * Parses the leading decimal digits of many fields at once with the active `simd_level`.
+ * @param fields The fields to parse, signs already removed.
+ * @param count The number of fields.
+ * @param values The value of each field, see `parse_decimal_digits`.
+ * @param digits The number of leading digits of each field, see `parse_decimal_digits`.
  */
-auto is_float(std::string_view data) -> bool;
+auto parse_decimal_fields(const std::string_view* fields, std::size_t count, uint64_t* values, uint8_t* digits)
+    -> void;
 
 /**
- * @note This currently requires taking a copy of `data` if the integer check fails
- *       to meet the floating point to_number limitations.
- *
- * @param data Determines if `data` is an number.
- * @return True if `data` starts with an integer value.
+ * @return The parsed digits as `integer` if they can't have overflowed it.
  */
-auto is_number(std::string_view data) -> bool;
+template<typename integer>
+auto decimal_value(uint64_t value, std::size_t digits, bool negative) -> std::optional<integer>
+{
+    if (digits == 0 || digits > static_cast<std::size_t>(std::numeric_limits<integer>::digits10))
+    {
+        return std::nullopt;
+    }
+    if constexpr (std::is_signed_v<integer>)
+    {
+        if (negative)
+        {
+            return static_cast<integer>(-static_cast<int64_t>(value));
+        }
+    }
+    return static_cast<integer>(value);
+}
+} // namespace detail
 
 /**
  * Converts an integer string_view to a number with no copies.
@@ -926,6 +3577,7 @@ auto is_number(std::string_view data) -> bool;
 template<typename integer, std::enable_if_t<std::is_integral_v<integer>, int> = 0>
 auto to_number(std::string_view data, uint64_t base = 10) -> std::optional<integer>
 {
+    CHAIN_INSTRUMENT_SCOPE(to_number, data.size());
     // https://en.cppreference.com/w/cpp/utility/from_chars
 
     if constexpr (std::is_unsigned<integer>::value)
@@ -942,65 +3594,326 @@ auto to_number(std::string_view data, uint64_t base = 10) -> std::optional<integ
         data.remove_prefix(1);
     }
 
+    if (base == 10)
+    {
+        // Decimal values too short to overflow `integer` are parsed without std::from_chars.
+        const std::size_t sign = (std::is_signed_v<integer> && data.size() > 0 && data.front() == '-') ? 1 : 0;
+        uint64_t          value{0};
+        const auto        digits = detail::parse_decimal_digits(data.data() + sign, data.size() - sign, value);
+        if (auto fast = detail::decimal_value<integer>(value, digits, sign == 1); fast.has_value())
+        {
+            return fast;
+        }
+    }
+
     integer output{};
     auto    result = std::from_chars(data.data(), data.data() + data.length(), output, base);
 
     return (result.ec == std::errc::invalid_argument) ? std::nullopt : std::optional{output};
 }
 
-template<typename floating_point, std::enable_if_t<std::is_floating_point_v<floating_point>, int> = 0>
-auto to_number(const std::string& data) -> std::optional<floating_point>
+namespace detail
+{
+/**
+ * Parses a floating point value with std::from_chars, or std::strto* on a null terminated copy
+ * where the standard library doesn't provide floating point std::from_chars.  Neither throws.
+ * @param first The first character of the value, leading whitespace and '+' already removed.
+ * @param last One past the last character that may be part of the value.
+ * @param format std::chars_format::general or std::chars_format::hex without its "0x" prefix.
+ * @return The value if any prefix of [first, last) is a representable floating point value.
+ */
+template<typename floating_point>
+auto parse_floating(const char* first, const char* last, std::chars_format format) -> std::optional<floating_point>
 {
+#if CHAIN_FLOAT_CHARCONV
     floating_point output{};
+    const auto     result = std::from_chars(first, last, output, format);
+    if (result.ec != std::errc{})
+    {
+        return std::nullopt;
+    }
+    return output;
+#else
+    std::string copy{};
+    if (format == std::chars_format::hex)
+    {
+        copy.append("0x");
+    }
+    copy.append(first, last);
 
-    std::size_t pos{0};
+    char*      end{nullptr};
+    const auto saved = errno;
+    errno            = 0;
 
-    try
+    floating_point output{};
+    if constexpr (std::is_same_v<floating_point, float>)
     {
-        if constexpr (sizeof(floating_point) == sizeof(float))
-        {
-            output = std::stof(data, &pos);
-        }
-        else if constexpr (sizeof(floating_point) == sizeof(double))
-        {
-            output = std::stod(data, &pos);
-        }
-        else if constexpr (sizeof(floating_point) == sizeof(long double))
+        output = std::strtof(copy.c_str(), &end);
+    }
+    else if constexpr (std::is_same_v<floating_point, double>)
+    {
+        output = std::strtod(copy.c_str(), &end);
+    }
+    else
+    {
+        output = std::strtold(copy.c_str(), &end);
+    }
+
+    const bool parsed = (end != copy.c_str()) && errno != ERANGE;
+    errno             = saved;
+    return parsed ? std::optional{output} : std::nullopt;
+#endif
+}
+} // namespace detail
+
+/**
+ * Converts a floating point string_view to a number with no copies and no exceptions, rounding
+ * correctly.  Like std::stod leading whitespace, a '+' sign and hexadecimal "0x" values are
+ * accepted and parsing stops at the first character that isn't part of the value.
+ * @tparam floating_point The output number type, float, double or long double.
+ * @param data The data to convert to a number.
+ * @return The number if converted, std::nullopt if `data` isn't a number or is out of range.
+ */
+template<typename floating_point, std::enable_if_t<std::is_floating_point_v<floating_point>, int> = 0>
+auto to_number(std::string_view data) -> std::optional<floating_point>
+{
+    CHAIN_INSTRUMENT_SCOPE(to_number, data.size());
+    std::size_t i{0};
+    while (i < data.size() && detail::ascii_space(static_cast<unsigned char>(data[i])))
+    {
+        ++i;
+    }
+
+    bool negative{false};
+    if (i < data.size() && (data[i] == '+' || data[i] == '-'))
+    {
+        negative = data[i] == '-';
+        ++i;
+    }
+
+    const char* first = data.data() + i;
+    const char* last  = data.data() + data.size();
+
+    // std::from_chars accepts '-' itself but not "0x", so the sign is always applied here.
+    auto format = std::chars_format::general;
+    if (last - first > 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X') &&
+        (detail::ascii_xdigit(static_cast<unsigned char>(first[2])) || first[2] == '.'))
+    {
+        first += 2;
+        format = std::chars_format::hex;
+    }
+    else if (first != last && *first == '-')
+    {
+        return std::nullopt;
+    }
+
+    auto value = detail::parse_floating<floating_point>(first, last, format);
+    if (value.has_value() && negative)
+    {
+        value = -value.value();
+    }
+    return value;
+}
+
+/**
+ * Converts many fields to numbers, the same as calling `to_number` on each.  Decimal integers
+ * are parsed a block at a time with the active `simd_level`, e.g. the columns of a split record.
+ * @tparam number The output number type.
+ * @tparam range_type A range of values convertible to std::string_view.
+ * @param fields The data to convert to numbers.
+ * @param out Receives the converted number of each field in order, or std::nullopt if it didn't convert.
+ * @return The number of fields converted.
+ */
+template<typename number, typename range_type>
+auto to_numbers(const range_type& fields, std::vector<std::optional<number>>& out) -> std::size_t
+{
+    CHAIN_INSTRUMENT_SCOPE(to_number, 0);
+    std::size_t converted{0};
+
+    if constexpr (std::is_integral_v<number>)
+    {
+        constexpr std::size_t                block = 64;
+        std::array<std::string_view, block> digits{};
+        std::array<bool, block>             negative{};
+        std::array<uint64_t, block>         values{};
+        std::array<uint8_t, block>          counts{};
+
+        auto it = std::begin(fields);
+        while (it != std::end(fields))
         {
-            output = std::stold(data, &pos);
+            auto        first = it;
+            std::size_t n{0};
+            for (; it != std::end(fields) && n < block; ++it, ++n)
+            {
+                std::string_view field{*it};
+                if (!field.empty() && field.front() == '+')
+                {
+                    field.remove_prefix(1);
+                }
+                negative[n] = std::is_signed_v<number> && !field.empty() && field.front() == '-';
+                if (negative[n])
+                {
+                    field.remove_prefix(1);
+                }
+                // Unsigned negative values are left to `to_number` to reject.
+                digits[n] = field;
+            }
+
+            detail::parse_decimal_fields(digits.data(), n, values.data(), counts.data());
+
+            for (std::size_t i = 0; i < n; ++i, ++first)
+            {
+                auto value = detail::decimal_value<number>(values[i], counts[i], negative[i]);
+                if (!value.has_value())
+                {
+                    value = to_number<number>(std::string_view{*first});
+                }
+                converted += value.has_value() ? 1 : 0;
+                out.push_back(value);
+            }
         }
-        else
+    }
+    else
+    {
+        for (const auto& field : fields)
         {
-            return std::nullopt;
+            auto value = to_number<number>(std::string_view{field});
+            converted += value.has_value() ? 1 : 0;
+            out.push_back(value);
         }
     }
-    catch (...)
+
+    return converted;
+}
+
+/**
+ * Converts many fields to numbers, see `to_numbers`.
+ * @tparam number The output number type.
+ * @tparam range_type A range of values convertible to std::string_view.
+ * @param fields The data to convert to numbers.
+ * @return The converted number of each field in order, or std::nullopt if it didn't convert.
+ */
+template<typename number, typename range_type>
+auto to_numbers(const range_type& fields) -> std::vector<std::optional<number>>
+{
+    std::vector<std::optional<number>> out{};
+    out.reserve(static_cast<std::size_t>(std::distance(std::begin(fields), std::end(fields))));
+    to_numbers<number>(fields, out);
+    return out;
+}
+
+namespace detail
+{
+/**
+ * Converts a single split field into `out`.
+ * @tparam field_type std::string_view, std::string or an arithmetic type.
+ * @param part The field to convert.
+ * @param out The converted field, untouched if the conversion fails.
+ * @return True if `part` converted.
+ */
+template<typename field_type>
+auto split_field(std::string_view part, field_type& out) -> bool
+{
+    if constexpr (std::is_same_v<field_type, std::string_view>)
+    {
+        out = part;
+        return true;
+    }
+    else if constexpr (std::is_same_v<field_type, std::string>)
     {
-        return std::nullopt;
+        out.assign(part.data(), part.length());
+        return true;
     }
+    else
+    {
+        static_assert(
+            std::is_arithmetic_v<field_type>, "split_as fields must be std::string_view, std::string or arithmetic");
 
-    return output;
+        auto value = to_number<field_type>(part);
+        if (!value.has_value())
+        {
+            return false;
+        }
+        out = value.value();
+        return true;
+    }
+}
+
+template<typename delim_type, typename tuple_type, std::size_t... indices>
+auto split_fields(std::string_view data, const delim_type& delim, tuple_type& out, std::index_sequence<indices...>)
+    -> bool
+{
+    std::size_t index{0};
+    bool        converted{true};
+
+    split_for_each(data, delim, [&](std::string_view part) -> bool {
+        // Only the field matching the current index converts, a surplus field fails the whole record.
+        converted = ((index == indices && split_field(part, std::get<indices>(out))) || ...);
+        ++index;
+        return converted;
+    });
+
+    return converted && index == sizeof...(indices);
 }
+} // namespace detail
 
 /**
- * Converts a floating point string_view to a number, this currently requires taking
- * a copy into a std::string to guarantee its null terminated, this limitation will exist until
- * std::from_chars() correctly supports floating point values.
- * @tparam floating_point The output number type.
- * @param data The data to convert to a number.
- * @return The number if converted.
+ * Splits `data` by `delim` and converts each field into the given references in a single pass
+ * without allocating, e.g. `split_into(line, ',', record.id, record.name, record.price)`.
+ * @tparam delim_type char, std::string_view or a precompiled searcher, use a
+ *                    `searcher<case_t::insensitive>` for case insensitive delimiters.
+ * @tparam field_types std::string_view, std::string or arithmetic types, see `to_number`.
+ * @param data The record to split, std::string_view fields point into `data`.
+ * @param delim The delimiter between fields.
+ * @param out The fields to write, a field that fails to convert stops the split and leaves
+ *            it and any following fields untouched.
+ * @return True if `data` has exactly `sizeof...(field_types)` fields and each converted.
  */
-template<typename floating_point, std::enable_if_t<std::is_floating_point_v<floating_point>, int> = 0>
-auto to_number(std::string_view data_view) -> std::optional<floating_point>
+template<typename delim_type, typename... field_types>
+auto split_into(std::string_view data, const delim_type& delim, field_types&... out) -> bool
+{
+    auto fields = std::tie(out...);
+    return detail::split_fields(data, delim, fields, std::index_sequence_for<field_types...>{});
+}
+
+/**
+ * Splits `data` by `delim` and converts each field into a typed tuple in a single pass
+ * without allocating, e.g. `split_as<int64_t, std::string_view, double>(line, ',')`.
+ * @tparam field_types std::string_view, std::string or arithmetic types, see `to_number`.
+ * @tparam delim_type char, std::string_view or a precompiled searcher.
+ * @param data The record to split, std::string_view fields point into `data`.
+ * @param delim The delimiter between fields.
+ * @return The converted fields, or std::nullopt if the field count doesn't match or any
+ *         field fails to convert.
+ */
+template<typename... field_types, typename delim_type>
+auto split_as(std::string_view data, const delim_type& delim) -> std::optional<std::tuple<field_types...>>
 {
-    std::string data{data_view.data(), data_view.length()};
-    return to_number<floating_point>(data);
+    std::tuple<field_types...> fields{};
+    if (!detail::split_fields(data, delim, fields, std::index_sequence_for<field_types...>{}))
+    {
+        return std::nullopt;
+    }
+    return fields;
 }
 
+/**
+ * The messages of errno values below 256 are looked up once on first use and shared by every
+ * thread, later calls don't allocate or call into libc.  Other values are formatted once each
+ * into a cache shared behind a lock.
+ * @param errsv The errno value to get its string representation.
+ * @return Human readable representation of `errsv`, this view is valid for the life of the program.
+ */
+auto strerror_view(int errsv) -> std::string_view;
+
 /**
  * @param errsv The errno value to get its string representation.
- * @return Human readable representation of `errsv`.
+ * @return Human readable representation of `errsv`, see `strerror_view`.
  */
 auto strerror(int errsv) -> std::string;
 
 } // namespace chain::str
+
+#if defined(CHAIN_HEADER_ONLY)
+    #include "chain/chain.inl"
+#endif
@@ -0,0 +1,1190 @@
+// The out of line implementation of chain/chain.hpp.  It is compiled once by src/chain.cpp for the
+// `chain` static library, or included by chain/chain.hpp with every function inline when
+// CHAIN_HEADER_ONLY is defined.
+
+#include "chain/chain.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define CHAIN_SIMD_X86 1
+    #include <immintrin.h>
+#else
+    #define CHAIN_SIMD_X86 0
+#endif
+
+namespace chain::str
+{
+CHAIN_INLINE const std::stringstream g_ss_default_fmt{};
+
+namespace detail
+{
+namespace scalar
+{
+CHAIN_INLINE auto equal_insensitive(const char* left, const char* right, std::size_t n) -> bool
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (ascii_lower(static_cast<unsigned char>(left[i])) != ascii_lower(static_cast<unsigned char>(right[i])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Searches candidate start positions [begin, end) front to back, first and last bytes are
+ * checked before the middle.
+ */
+CHAIN_INLINE auto find_insensitive(const char* data, std::size_t begin, std::size_t end, std::string_view needle)
+    -> std::size_t
+{
+    const std::size_t n        = needle.size();
+    const auto        first_ch = ascii_lower(static_cast<unsigned char>(needle.front()));
+    const auto        last_ch  = ascii_lower(static_cast<unsigned char>(needle.back()));
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        if (ascii_lower(static_cast<unsigned char>(data[i])) == first_ch &&
+            ascii_lower(static_cast<unsigned char>(data[i + n - 1])) == last_ch &&
+            (n <= 2 || equal_insensitive(data + i + 1, needle.data() + 1, n - 2)))
+        {
+            return i;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+/**
+ * Searches candidate start positions [0, end) back to front.
+ */
+CHAIN_INLINE auto rfind_insensitive(const char* data, std::size_t end, std::string_view needle) -> std::size_t
+{
+    const std::size_t n        = needle.size();
+    const auto        first_ch = ascii_lower(static_cast<unsigned char>(needle.front()));
+    const auto        last_ch  = ascii_lower(static_cast<unsigned char>(needle.back()));
+
+    while (end > 0)
+    {
+        --end;
+        if (ascii_lower(static_cast<unsigned char>(data[end])) == first_ch &&
+            ascii_lower(static_cast<unsigned char>(data[end + n - 1])) == last_ch &&
+            (n <= 2 || equal_insensitive(data + end + 1, needle.data() + 1, n - 2)))
+        {
+            return end;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+/**
+ * Flips the ASCII case bit of every byte of `word` in [first, last], 8 bytes at a time (SWAR).
+ * Only the low 7 bits take part in the range checks so no lane can carry into its neighbour,
+ * bytes with the high bit set are never in range.
+ */
+inline auto swar_flip_case(uint64_t word, unsigned char first, unsigned char last) -> uint64_t
+{
+    constexpr uint64_t ones = 0x0101010101010101ULL;
+    constexpr uint64_t high = 0x8080808080808080ULL;
+
+    const uint64_t low7     = word & ~high;
+    const uint64_t at_least = low7 + (0x80U - first) * ones;
+    const uint64_t past     = low7 + (0x7FU - last) * ones;
+    const uint64_t in_range = (at_least ^ past) & ~word & high;
+
+    // 0x80 >> 2 is the 0x20 case bit.
+    return word ^ (in_range >> 2);
+}
+
+CHAIN_INLINE auto to_lower(const char* in, char* out, std::size_t n) -> void
+{
+    std::size_t i = 0;
+    for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, in + i, sizeof(word));
+        word = swar_flip_case(word, 'A', 'Z');
+        std::memcpy(out + i, &word, sizeof(word));
+    }
+    for (; i < n; ++i)
+    {
+        out[i] = static_cast<char>(ascii_lower(static_cast<unsigned char>(in[i])));
+    }
+}
+
+CHAIN_INLINE auto to_upper(const char* in, char* out, std::size_t n) -> void
+{
+    std::size_t i = 0;
+    for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, in + i, sizeof(word));
+        word = swar_flip_case(word, 'a', 'z');
+        std::memcpy(out + i, &word, sizeof(word));
+    }
+    for (; i < n; ++i)
+    {
+        out[i] = static_cast<char>(ascii_upper(static_cast<unsigned char>(in[i])));
+    }
+}
+
+/**
+ * @return The number of leading whitespace bytes.
+ */
+CHAIN_INLINE auto trim_left(const char* data, std::size_t n) -> std::size_t
+{
+    std::size_t i = 0;
+    while (i < n && ascii_space(static_cast<unsigned char>(data[i])))
+    {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * @return The number of trailing whitespace bytes.
+ */
+CHAIN_INLINE auto trim_right(const char* data, std::size_t n) -> std::size_t
+{
+    std::size_t end = n;
+    while (end > 0 && ascii_space(static_cast<unsigned char>(data[end - 1])))
+    {
+        --end;
+    }
+    return n - end;
+}
+
+/**
+ * Finds the matches starting in [begin, end), matches starting before `next` are skipped.
+ * @return The number of matches found.
+ */
+CHAIN_INLINE auto find_all_from(
+    const char*               data,
+    std::size_t               begin,
+    std::size_t               end,
+    std::string_view          needle,
+    bool                      fold,
+    bool                      overlapping,
+    std::size_t               next,
+    std::vector<std::size_t>* out) -> std::size_t
+{
+    const std::size_t n     = needle.size();
+    std::size_t       found = 0;
+
+    for (std::size_t i = std::max(begin, next); i < end;)
+    {
+        const bool match = fold ? equal_insensitive(data + i, needle.data(), n)
+                                : std::memcmp(data + i, needle.data(), n) == 0;
+        if (match)
+        {
+            ++found;
+            if (out != nullptr)
+            {
+                out->push_back(i);
+            }
+            i += overlapping ? 1 : n;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return found;
+}
+
+CHAIN_INLINE auto find_all(
+    const char*               data,
+    std::size_t               size,
+    std::string_view          needle,
+    bool                      fold,
+    bool                      overlapping,
+    std::vector<std::size_t>* out) -> std::size_t
+{
+    return find_all_from(data, 0, size - needle.size() + 1, needle, fold, overlapping, 0, out);
+}
+
+/**
+ * @return Bit i set for each of the first `size` (at most 64) bytes equal to `c`.
+ */
+CHAIN_INLINE auto byte_mask(const char* data, std::size_t size, unsigned char c, bool fold) -> uint64_t
+{
+    uint64_t mask{0};
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        auto b = static_cast<unsigned char>(data[i]);
+        if (fold)
+        {
+            b = ascii_lower(b);
+        }
+        mask |= uint64_t{b == c} << i;
+    }
+    return mask;
+}
+
+CHAIN_INLINE auto byte_masks(const char* data, std::size_t size, unsigned char c, bool fold, uint64_t* masks) -> void
+{
+    for (std::size_t i = 0; i < size; i += 64)
+    {
+        masks[i / 64] = byte_mask(data + i, std::min<std::size_t>(64, size - i), c, fold);
+    }
+}
+
+CHAIN_INLINE auto
+    parse_decimal_fields(const std::string_view* fields, std::size_t count, uint64_t* values, uint8_t* digits) -> void
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        digits[i] = static_cast<uint8_t>(parse_decimal_digits(fields[i].data(), fields[i].size(), values[i]));
+    }
+}
+
+} // namespace scalar
+
+#if CHAIN_SIMD_X86
+
+    // Each instruction set below is compiled with its own target so a single binary carries every
+    // level and picks one at runtime, the enclosing translation unit keeps the baseline target.
+    #if defined(__clang__)
+        #pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+    #else
+        #pragma GCC push_options
+        #pragma GCC target("sse2")
+    #endif
+
+namespace sse2
+{
+struct ops
+{
+    using vec = __m128i;
+
+    static constexpr std::size_t width     = 16;
+    static constexpr uint64_t    full_mask = 0xFFFF;
+
+    static auto load(const char* p) -> vec { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static auto store(char* p, vec v) -> void { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+    static auto load_partial(const char* p, std::size_t n) -> vec
+    {
+        alignas(16) char buffer[16] = {};
+        std::memcpy(buffer, p, n);
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(buffer));
+    }
+
+    static auto splat(unsigned char c) -> vec { return _mm_set1_epi8(static_cast<char>(c)); }
+
+    static auto eq_mask(vec a, vec b) -> uint64_t
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+    }
+
+    /**
+     * Lanes in [lo, lo + count).  Shifting `lo` to -128 turns the unsigned range check into a
+     * single signed compare which is all SSE2 offers.
+     */
+    static auto in_range(vec v, unsigned char lo, unsigned char count) -> vec
+    {
+        const vec shifted = _mm_add_epi8(v, splat(static_cast<unsigned char>(0x80 - lo)));
+        return _mm_cmplt_epi8(shifted, splat(static_cast<unsigned char>(0x80 + count)));
+    }
+
+    static auto to_lower(vec v) -> vec { return _mm_xor_si128(v, _mm_and_si128(in_range(v, 'A', 26), splat(0x20))); }
+    static auto to_upper(vec v) -> vec { return _mm_xor_si128(v, _mm_and_si128(in_range(v, 'a', 26), splat(0x20))); }
+
+    static auto space_mask(vec v) -> uint64_t
+    {
+        const vec spaces = _mm_or_si128(_mm_cmpeq_epi8(v, splat(' ')), in_range(v, '\t', 5));
+        return static_cast<uint32_t>(_mm_movemask_epi8(spaces));
+    }
+};
+
+    #include "kernels.inl"
+
+// SSE2 has no multiply-add over bytes, the SWAR parser is as fast.
+using scalar::parse_decimal_fields;
+} // namespace sse2
+
+    #if defined(__clang__)
+        #pragma clang attribute pop
+        #pragma clang attribute push(__attribute__((target("sse4.2,popcnt"))), apply_to = function)
+    #else
+        #pragma GCC pop_options
+        #pragma GCC push_options
+        #pragma GCC target("sse4.2,popcnt")
+    #endif
+
+// SSE4.2's string instructions lose to the SSE2 compare and movemask kernels, this level re-compiles
+// them so the compiler may use the newer instructions it sees fit.
+namespace sse42
+{
+using ops = sse2::ops;
+    #include "kernels.inl"
+
+/**
+ * Converts 16 ASCII digits to their value, pairs of digits are combined with a byte multiply-add,
+ * then pairs of pairs, then the 4 digit groups into two 8 digit halves.
+ */
+CHAIN_INLINE auto parse_sixteen(__m128i digits) -> uint64_t
+{
+    __m128i v = _mm_sub_epi8(digits, _mm_set1_epi8('0'));
+    v         = _mm_maddubs_epi16(v, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+    v         = _mm_madd_epi16(v, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+    v         = _mm_packus_epi32(v, v);
+    v         = _mm_madd_epi16(v, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+
+    const auto high = static_cast<uint64_t>(static_cast<uint32_t>(_mm_cvtsi128_si32(v)));
+    const auto low  = static_cast<uint64_t>(static_cast<uint32_t>(_mm_extract_epi32(v, 1)));
+    return high * 100000000 + low;
+}
+
+CHAIN_INLINE auto
+    parse_decimal_fields(const std::string_view* fields, std::size_t count, uint64_t* values, uint8_t* digits) -> void
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const char*       data = fields[i].data();
+        const std::size_t size = fields[i].size();
+
+        if (size >= 16)
+        {
+            const auto     block = ops::load(data);
+            const uint64_t mask  = ops::eq_mask(ops::in_range(block, '0', 10), ops::splat(0xFF));
+            if (mask == ops::full_mask)
+            {
+                // The remaining digits can't overflow, at most `max_decimal_digits` are accumulated.
+                uint64_t    value = parse_sixteen(block);
+                std::size_t n     = 16;
+                for (; n < size && static_cast<unsigned char>(data[n] - '0') < 10; ++n)
+                {
+                    if (n == max_decimal_digits)
+                    {
+                        ++n;
+                        break;
+                    }
+                    value = value * 10 + static_cast<uint64_t>(data[n] - '0');
+                }
+                values[i] = value;
+                digits[i] = static_cast<uint8_t>(n);
+                continue;
+            }
+        }
+
+        digits[i] = static_cast<uint8_t>(parse_decimal_digits(data, size, values[i]));
+    }
+}
+} // namespace sse42
+
+    #if defined(__clang__)
+        #pragma clang attribute pop
+        #pragma clang attribute push(__attribute__((target("avx2,bmi,bmi2,popcnt"))), apply_to = function)
+    #else
+        #pragma GCC pop_options
+        #pragma GCC push_options
+        #pragma GCC target("avx2,bmi,bmi2,popcnt")
+    #endif
+
+namespace avx2
+{
+struct ops
+{
+    using vec = __m256i;
+
+    static constexpr std::size_t width     = 32;
+    static constexpr uint64_t    full_mask = 0xFFFFFFFF;
+
+    static auto load(const char* p) -> vec { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static auto store(char* p, vec v) -> void { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+    static auto load_partial(const char* p, std::size_t n) -> vec
+    {
+        alignas(32) char buffer[32] = {};
+        std::memcpy(buffer, p, n);
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(buffer));
+    }
+
+    static auto splat(unsigned char c) -> vec { return _mm256_set1_epi8(static_cast<char>(c)); }
+
+    static auto eq_mask(vec a, vec b) -> uint64_t
+    {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    }
+
+    /**
+     * Lanes in [lo, lo + count), see `sse2::ops::in_range`.
+     */
+    static auto in_range(vec v, unsigned char lo, unsigned char count) -> vec
+    {
+        const vec shifted = _mm256_add_epi8(v, splat(static_cast<unsigned char>(0x80 - lo)));
+        return _mm256_cmpgt_epi8(splat(static_cast<unsigned char>(0x80 + count)), shifted);
+    }
+
+    static auto to_lower(vec v) -> vec
+    {
+        return _mm256_xor_si256(v, _mm256_and_si256(in_range(v, 'A', 26), splat(0x20)));
+    }
+
+    static auto to_upper(vec v) -> vec
+    {
+        return _mm256_xor_si256(v, _mm256_and_si256(in_range(v, 'a', 26), splat(0x20)));
+    }
+
+    static auto space_mask(vec v) -> uint64_t
+    {
+        const vec spaces = _mm256_or_si256(_mm256_cmpeq_epi8(v, splat(' ')), in_range(v, '\t', 5));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(spaces));
+    }
+};
+
+    #include "kernels.inl"
+
+using sse42::parse_decimal_fields;
+} // namespace avx2
+
+    #if defined(__clang__)
+        #pragma clang attribute pop
+        #pragma clang attribute push(                                                                                  \
+            __attribute__((target("avx512f,avx512bw,avx2,bmi,bmi2,popcnt"))), apply_to = function)
+    #else
+        #pragma GCC pop_options
+        #pragma GCC push_options
+        #pragma GCC target("avx512f,avx512bw,avx2,bmi,bmi2,popcnt")
+    #endif
+
+namespace avx512
+{
+struct ops
+{
+    using vec = __m512i;
+
+    static constexpr std::size_t width     = 64;
+    static constexpr uint64_t    full_mask = ~uint64_t{0};
+
+    static auto load(const char* p) -> vec { return _mm512_loadu_si512(p); }
+    static auto store(char* p, vec v) -> void { _mm512_storeu_si512(p, v); }
+
+    /**
+     * Masked loads suppress faults on the lanes not selected so nothing past `n` is touched.
+     */
+    static auto load_partial(const char* p, std::size_t n) -> vec
+    {
+        return _mm512_maskz_loadu_epi8(_bzhi_u64(~uint64_t{0}, static_cast<unsigned int>(n)), p);
+    }
+
+    static auto splat(unsigned char c) -> vec { return _mm512_set1_epi8(static_cast<char>(c)); }
+
+    static auto eq_mask(vec a, vec b) -> uint64_t { return _mm512_cmpeq_epi8_mask(a, b); }
+
+    /**
+     * Lanes in [lo, lo + count), AVX-512 has native unsigned compares into mask registers.
+     */
+    static auto in_range(vec v, unsigned char lo, unsigned char count) -> __mmask64
+    {
+        return _mm512_cmplt_epu8_mask(_mm512_sub_epi8(v, splat(lo)), splat(count));
+    }
+
+    static auto to_lower(vec v) -> vec { return flip(v, in_range(v, 'A', 26)); }
+    static auto to_upper(vec v) -> vec { return flip(v, in_range(v, 'a', 26)); }
+
+    static auto space_mask(vec v) -> uint64_t { return _mm512_cmpeq_epi8_mask(v, splat(' ')) | in_range(v, '\t', 5); }
+
+    /**
+     * Flips the ASCII case bit of the lanes selected by `m`.
+     */
+    static auto flip(vec v, __mmask64 m) -> vec
+    {
+        return _mm512_mask_blend_epi8(m, v, _mm512_xor_si512(v, splat(0x20)));
+    }
+};
+
+    #include "kernels.inl"
+
+using sse42::parse_decimal_fields;
+} // namespace avx512
+
+    #if defined(__clang__)
+        #pragma clang attribute pop
+    #else
+        #pragma GCC pop_options
+    #endif
+
+#endif // CHAIN_SIMD_X86
+
+/**
+ * The kernels for a single simd_level, every accelerated function calls through the active table.
+ */
+struct kernel_table
+{
+    simd_level level;
+    std::size_t (*find_insensitive)(const char*, std::size_t, std::size_t, std::string_view);
+    std::size_t (*rfind_insensitive)(const char*, std::size_t, std::string_view);
+    void (*to_lower)(const char*, char*, std::size_t);
+    void (*to_upper)(const char*, char*, std::size_t);
+    bool (*equal_insensitive)(const char*, const char*, std::size_t);
+    std::size_t (*trim_left)(const char*, std::size_t);
+    std::size_t (*trim_right)(const char*, std::size_t);
+    std::size_t (*find_all)(const char*, std::size_t, std::string_view, bool, bool, std::vector<std::size_t>*);
+    void (*byte_masks)(const char*, std::size_t, unsigned char, bool, uint64_t*);
+    void (*parse_decimal_fields)(const std::string_view*, std::size_t, uint64_t*, uint8_t*);
+};
+
+#define CHAIN_KERNEL_TABLE(level, ns)                                                                                  \
+    kernel_table                                                                                                       \
+    {                                                                                                                  \
+        level, &ns::find_insensitive, &ns::rfind_insensitive, &ns::to_lower, &ns::to_upper, &ns::equal_insensitive,    \
+            &ns::trim_left, &ns::trim_right, &ns::find_all, &ns::byte_masks, &ns::parse_decimal_fields                \
+    }
+
+CHAIN_INLINE constexpr kernel_table g_scalar_kernels = CHAIN_KERNEL_TABLE(simd_level::scalar, scalar);
+#if CHAIN_SIMD_X86
+CHAIN_INLINE constexpr kernel_table g_sse2_kernels   = CHAIN_KERNEL_TABLE(simd_level::sse2, sse2);
+CHAIN_INLINE constexpr kernel_table g_sse42_kernels  = CHAIN_KERNEL_TABLE(simd_level::sse42, sse42);
+CHAIN_INLINE constexpr kernel_table g_avx2_kernels   = CHAIN_KERNEL_TABLE(simd_level::avx2, avx2);
+CHAIN_INLINE constexpr kernel_table g_avx512_kernels = CHAIN_KERNEL_TABLE(simd_level::avx512, avx512);
+#endif
+
+#undef CHAIN_KERNEL_TABLE
+
+/// The active kernels, null until the first accelerated call or `force_simd_level()`.
+CHAIN_INLINE std::atomic<const kernel_table*> g_kernels{nullptr};
+
+CHAIN_INLINE auto kernels_for(simd_level level) -> const kernel_table*
+{
+    switch (level)
+    {
+#if CHAIN_SIMD_X86
+        case simd_level::avx512:
+            return &g_avx512_kernels;
+        case simd_level::avx2:
+            return &g_avx2_kernels;
+        case simd_level::sse42:
+            return &g_sse42_kernels;
+        case simd_level::sse2:
+            return &g_sse2_kernels;
+#endif
+        default:
+            return &g_scalar_kernels;
+    }
+}
+
+/**
+ * @return The level requested by the CHAIN_SIMD_LEVEL environment variable, if set and valid.
+ */
+CHAIN_INLINE auto env_simd_level() -> std::optional<simd_level>
+{
+    const char* env = std::getenv("CHAIN_SIMD_LEVEL");
+    if (env == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    return simd_level_from_string(env);
+}
+
+CHAIN_INLINE auto kernels() -> const kernel_table&
+{
+    const kernel_table* active = g_kernels.load(std::memory_order_acquire);
+    if (active == nullptr)
+    {
+        // Racing first calls all select the same table so there is nothing to synchronize.
+        auto level = detected_simd_level();
+        if (auto requested = env_simd_level(); requested.has_value())
+        {
+            level = std::min(level, requested.value());
+        }
+
+        active = kernels_for(level);
+        g_kernels.store(active, std::memory_order_release);
+    }
+    return *active;
+}
+
+CHAIN_INLINE auto find_insensitive(std::string_view haystack, std::string_view needle, std::size_t pos) -> std::size_t
+{
+    if (pos > haystack.size())
+    {
+        return std::string_view::npos;
+    }
+    if (needle.empty())
+    {
+        return (pos < haystack.size()) ? pos : std::string_view::npos;
+    }
+    if (needle.size() > haystack.size() - pos)
+    {
+        return std::string_view::npos;
+    }
+
+    return kernels().find_insensitive(haystack.data(), pos, haystack.size() - needle.size() + 1, needle);
+}
+
+CHAIN_INLINE auto rfind_insensitive(std::string_view haystack, std::string_view needle, std::size_t pos) -> std::size_t
+{
+    // The match must end at or before `limit`.
+    const std::size_t limit = std::min(pos, haystack.size());
+    if (needle.empty())
+    {
+        return (limit > 0) ? limit : std::string_view::npos;
+    }
+    if (needle.size() > limit)
+    {
+        return std::string_view::npos;
+    }
+
+    return kernels().rfind_insensitive(haystack.data(), limit - needle.size() + 1, needle);
+}
+
+CHAIN_INLINE auto equal_insensitive(std::string_view left, std::string_view right) -> bool
+{
+    return left.size() == right.size() && kernels().equal_insensitive(left.data(), right.data(), left.size());
+}
+
+CHAIN_INLINE auto find_all(
+    std::string_view          haystack,
+    std::string_view          needle,
+    bool                      fold,
+    bool                      overlapping,
+    std::vector<std::size_t>* out) -> std::size_t
+{
+    if (needle.empty() || needle.size() > haystack.size())
+    {
+        return 0;
+    }
+
+    return kernels().find_all(haystack.data(), haystack.size(), needle, fold, overlapping, out);
+}
+
+CHAIN_INLINE auto byte_masks(const char* data, std::size_t size, unsigned char c, bool fold, uint64_t* masks) -> void
+{
+    kernels().byte_masks(data, size, c, fold, masks);
+}
+
+CHAIN_INLINE auto
+    parse_decimal_fields(const std::string_view* fields, std::size_t count, uint64_t* values, uint8_t* digits) -> void
+{
+    kernels().parse_decimal_fields(fields, count, values, digits);
+}
+
+} // namespace detail
+
+CHAIN_INLINE auto detected_simd_level() -> simd_level
+{
+#if CHAIN_SIMD_X86
+    static const simd_level detected = []() -> simd_level {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        {
+            return simd_level::avx512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2"))
+        {
+            return simd_level::avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+        {
+            return simd_level::sse42;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return simd_level::sse2;
+        }
+        return simd_level::scalar;
+    }();
+    return detected;
+#else
+    return simd_level::scalar;
+#endif
+}
+
+CHAIN_INLINE auto active_simd_level() -> simd_level
+{
+    return detail::kernels().level;
+}
+
+CHAIN_INLINE auto force_simd_level(simd_level level) -> simd_level
+{
+    const auto* table = detail::kernels_for(std::min(level, detected_simd_level()));
+    detail::g_kernels.store(table, std::memory_order_release);
+    return table->level;
+}
+
+CHAIN_INLINE auto simd_level_from_string(std::string_view name) -> std::optional<simd_level>
+{
+    for (auto level : {simd_level::scalar, simd_level::sse2, simd_level::sse42, simd_level::avx2, simd_level::avx512})
+    {
+        // The scalar compare, this runs while the kernels are still being selected.
+        const auto candidate = to_string(level);
+        if (name.size() == candidate.size() &&
+            detail::scalar::equal_insensitive(name.data(), candidate.data(), name.size()))
+        {
+            return level;
+        }
+    }
+    return std::nullopt;
+}
+
+CHAIN_INLINE auto to_string(simd_level level) -> std::string_view
+{
+    switch (level)
+    {
+        case simd_level::scalar:
+            return "scalar";
+        case simd_level::sse2:
+            return "sse2";
+        case simd_level::sse42:
+            return "sse4.2";
+        case simd_level::avx2:
+            return "avx2";
+        case simd_level::avx512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+#if CHAIN_INSTRUMENT
+namespace detail
+{
+/**
+ * Every live thread's counters, plus the totals of exited threads.  The lock is only taken when a
+ * thread first records, when it exits and for `global_snapshot()`, never while recording.
+ */
+struct instrument_registry
+{
+    std::mutex                              lock{};
+    std::vector<const instrument_counters*> live{};
+    instrument::snapshot                    exited{};
+};
+
+CHAIN_INLINE auto instrument_registry_instance() -> instrument_registry&
+{
+    // Never destroyed, threads may still exit after static destruction has started.
+    static auto* registry = new instrument_registry{};
+    return *registry;
+}
+
+CHAIN_INLINE auto read(const instrument_counters& counters) -> instrument::snapshot
+{
+    instrument::snapshot out{};
+    for (std::size_t f = 0; f < instrument::function_count; ++f)
+    {
+        const auto& from = counters.functions[f];
+        auto&       to   = out.functions[f];
+        to.calls         = from.calls.load(std::memory_order_relaxed);
+        to.bytes         = from.bytes.load(std::memory_order_relaxed);
+        to.total_ns      = from.total_ns.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < instrument::latency_buckets; ++i)
+        {
+            to.latency[i] = from.latency[i].load(std::memory_order_relaxed);
+        }
+    }
+    return out;
+}
+
+/**
+ * Registers a thread's counters for its lifetime and folds them into the exited totals after.
+ */
+class instrument_registration
+{
+public:
+    instrument_registration() : m_counters()
+    {
+        auto&                       registry = instrument_registry_instance();
+        std::lock_guard<std::mutex> guard{registry.lock};
+        registry.live.push_back(&m_counters);
+    }
+
+    instrument_registration(const instrument_registration&)                    = delete;
+    instrument_registration(instrument_registration&&)                         = delete;
+    auto operator=(const instrument_registration&) -> instrument_registration& = delete;
+    auto operator=(instrument_registration&&) -> instrument_registration&      = delete;
+
+    ~instrument_registration()
+    {
+        auto&                       registry = instrument_registry_instance();
+        std::lock_guard<std::mutex> guard{registry.lock};
+        registry.exited.merge(read(m_counters));
+        registry.live.erase(std::find(registry.live.begin(), registry.live.end(), &m_counters));
+    }
+
+    auto counters() -> instrument_counters& { return m_counters; }
+
+private:
+    instrument_counters m_counters;
+};
+
+CHAIN_INLINE auto thread_instrument_counters() -> instrument_counters&
+{
+    thread_local instrument_registration registration{};
+    return registration.counters();
+}
+
+CHAIN_INLINE auto instrument_depth() -> std::size_t&
+{
+    thread_local std::size_t depth{0};
+    return depth;
+}
+} // namespace detail
+#endif
+
+namespace instrument
+{
+CHAIN_INLINE auto thread_snapshot() -> snapshot
+{
+#if CHAIN_INSTRUMENT
+    return detail::read(detail::thread_instrument_counters());
+#else
+    return snapshot{};
+#endif
+}
+
+CHAIN_INLINE auto global_snapshot() -> snapshot
+{
+#if CHAIN_INSTRUMENT
+    auto&                       registry = detail::instrument_registry_instance();
+    std::lock_guard<std::mutex> guard{registry.lock};
+    snapshot                    out{registry.exited};
+    for (const auto* counters : registry.live)
+    {
+        out.merge(detail::read(*counters));
+    }
+    return out;
+#else
+    return snapshot{};
+#endif
+}
+
+CHAIN_INLINE auto to_string(function f) -> std::string_view
+{
+    switch (f)
+    {
+        case function::find:
+            return "find";
+        case function::rfind:
+            return "rfind";
+        case function::split:
+            return "split";
+        case function::join:
+            return "join";
+        case function::trim:
+            return "trim";
+        case function::to_lower:
+            return "to_lower";
+        case function::to_upper:
+            return "to_upper";
+        case function::replace:
+            return "replace";
+        case function::replace_all:
+            return "replace_all";
+        case function::to_number:
+            return "to_number";
+        case function::classify_number:
+            return "classify_number";
+        case function::strerror:
+            return "strerror";
+        case function::count:
+            break;
+    }
+    return "unknown";
+}
+} // namespace instrument
+
+CHAIN_INLINE auto to_lower_ascii(std::string_view data, char* out) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(to_lower, data.size());
+    detail::kernels().to_lower(data.data(), out, data.size());
+}
+
+CHAIN_INLINE auto to_upper_ascii(std::string_view data, char* out) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(to_upper, data.size());
+    detail::kernels().to_upper(data.data(), out, data.size());
+}
+
+CHAIN_INLINE auto to_lower(std::string& data) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(to_lower, data.size());
+    to_lower_ascii(data, data.data());
+}
+
+CHAIN_INLINE auto to_lower_copy(std::string_view data) -> std::string
+{
+    CHAIN_INSTRUMENT_SCOPE(to_lower, data.size());
+    // Converts while copying rather than copying and converting in place, `data` is only read once.
+    std::string copy(data.size(), '\0');
+    to_lower_ascii(data, copy.data());
+    return copy;
+}
+
+CHAIN_INLINE auto to_upper(std::string& data) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(to_upper, data.size());
+    to_upper_ascii(data, data.data());
+}
+
+CHAIN_INLINE auto to_upper_copy(std::string_view data) -> std::string
+{
+    CHAIN_INSTRUMENT_SCOPE(to_upper, data.size());
+    std::string copy(data.size(), '\0');
+    to_upper_ascii(data, copy.data());
+    return copy;
+}
+
+CHAIN_INLINE auto trim_left(std::string& data) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    data.erase(0, detail::kernels().trim_left(data.data(), data.size()));
+}
+
+CHAIN_INLINE auto trim_right(std::string& data) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    data.erase(data.size() - detail::kernels().trim_right(data.data(), data.size()));
+}
+
+CHAIN_INLINE auto trim(std::string& data) -> void
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    trim_left(data);
+    trim_right(data);
+}
+
+namespace detail
+{
+CHAIN_INLINE auto trim_left_view(std::string_view data) -> std::string_view
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    data.remove_prefix(kernels().trim_left(data.data(), data.size()));
+    return data;
+}
+
+CHAIN_INLINE auto trim_right_view(std::string_view data) -> std::string_view
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    data.remove_suffix(kernels().trim_right(data.data(), data.size()));
+    return data;
+}
+
+CHAIN_INLINE auto trim_view(std::string_view data) -> std::string_view
+{
+    CHAIN_INSTRUMENT_SCOPE(trim, data.size());
+    return trim_left_view(trim_right_view(data));
+}
+} // namespace detail
+
+CHAIN_INLINE auto classify_number(std::string_view data) -> number_classification
+{
+    CHAIN_INSTRUMENT_SCOPE(classify_number, data.size());
+    const std::size_t size = data.size();
+    std::size_t       i    = 0;
+    while (i < size && detail::ascii_space(static_cast<unsigned char>(data[i])))
+    {
+        ++i;
+    }
+    if (i < size && (data[i] == '+' || data[i] == '-'))
+    {
+        ++i;
+    }
+
+    auto skip = [&](std::size_t from, auto is_digit) -> std::size_t {
+        while (from < size && is_digit(static_cast<unsigned char>(data[from])))
+        {
+            ++from;
+        }
+        return from;
+    };
+    // Case insensitive, `word` is lower case.
+    auto matches = [&](std::size_t from, std::string_view word) -> bool {
+        if (size - from < word.size())
+        {
+            return false;
+        }
+        for (std::size_t j = 0; j < word.size(); ++j)
+        {
+            if (detail::ascii_lower(static_cast<unsigned char>(data[from + j])) != word[j])
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    auto digit  = [](unsigned char c) -> bool { return detail::ascii_digit(c); };
+    auto xdigit = [](unsigned char c) -> bool { return detail::ascii_xdigit(c); };
+
+    // Infinity and NaN, as parsed by to_number for floating point types.
+    if (matches(i, "inf"))
+    {
+        return {number_class::floating, i + (matches(i, "infinity") ? 8 : 3)};
+    }
+    if (matches(i, "nan"))
+    {
+        std::size_t end = i + 3;
+        if (end < size && data[end] == '(')
+        {
+            const std::size_t close = skip(end + 1, [](unsigned char c) -> bool {
+                const auto lower = detail::ascii_lower(c);
+                return detail::ascii_digit(c) || c == '_' || (lower >= 'a' && lower <= 'z');
+            });
+            if (close < size && data[close] == ')')
+            {
+                end = close + 1;
+            }
+        }
+        return {number_class::floating, end};
+    }
+
+    // A hexadecimal prefix is followed by digits, a fraction and a binary exponent the same as
+    // to_number for floating point types parses it.
+    const bool hex = i + 2 < size && data[i] == '0' && (data[i + 1] == 'x' || data[i + 1] == 'X') &&
+                     (detail::ascii_xdigit(static_cast<unsigned char>(data[i + 2])) || data[i + 2] == '.');
+    const std::size_t start    = hex ? i + 2 : i;
+    auto              is_digit = [&](unsigned char c) -> bool { return hex ? xdigit(c) : digit(c); };
+
+    const std::size_t integer_end = skip(start, is_digit);
+    std::size_t       end         = integer_end;
+    number_class      kind        = (integer_end > start) ? (hex ? number_class::hex : number_class::integer)
+                                                          : number_class::invalid;
+
+    if (end < size && data[end] == '.')
+    {
+        const std::size_t fraction_end = skip(end + 1, is_digit);
+        if (fraction_end > end + 1 || kind != number_class::invalid)
+        {
+            kind = number_class::floating;
+            end  = fraction_end;
+        }
+    }
+
+    if (kind == number_class::invalid)
+    {
+        return {};
+    }
+
+    const char exponent_char = hex ? 'p' : 'e';
+    if (end < size && detail::ascii_lower(static_cast<unsigned char>(data[end])) == exponent_char)
+    {
+        std::size_t exponent = end + 1;
+        if (exponent < size && (data[exponent] == '+' || data[exponent] == '-'))
+        {
+            ++exponent;
+        }
+        const std::size_t exponent_end = skip(exponent, digit);
+        if (exponent_end > exponent)
+        {
+            kind = number_class::exponent;
+            end  = exponent_end;
+        }
+    }
+
+    return {kind, end};
+}
+
+CHAIN_INLINE auto is_int(std::string_view data) -> bool
+{
+    // to_number for integer types doesn't skip leading whitespace or parse a hexadecimal prefix.
+    return !data.empty() && !detail::ascii_space(static_cast<unsigned char>(data[0])) &&
+           classify_number(data).kind == number_class::integer;
+}
+
+CHAIN_INLINE auto is_float(std::string_view data) -> bool
+{
+    const auto kind = classify_number(data).kind;
+    return kind == number_class::floating || kind == number_class::exponent;
+}
+
+CHAIN_INLINE auto is_number(std::string_view data) -> bool
+{
+    return classify_number(data).kind != number_class::invalid;
+}
+
+namespace detail
+{
+/// errno values below this are cached by `strerror_view`, Linux and the BSDs stay well below it.
+CHAIN_INLINE constexpr int errno_table_size = 256;
+
+CHAIN_INLINE auto strerror_copy(int errsv, std::string& out) -> void
+{
+    // strerror_r appears to ignore passed in buffer args, manually copy
+    // the data from the returned error_ptr.  The XSI complain version of this
+    // function would probably just work...
+    // TODO: might need some #defines to make this more portable for non-GNU.
+    constexpr std::size_t LEN = 256;
+    char                  buffer[LEN];
+    char*                 error_ptr = strerror_r(errsv, buffer, LEN);
+
+    out.assign(error_ptr, strnlen(error_ptr, LEN));
+}
+
+/**
+ * Every cached errno message back to back, message `i` is [offsets[i], offsets[i + 1]).
+ */
+struct errno_table
+{
+    std::string                                   messages{};
+    std::array<std::size_t, errno_table_size + 1> offsets{};
+};
+
+CHAIN_INLINE auto errno_messages() -> const errno_table&
+{
+    // Function local statics are initialized exactly once even with concurrent callers.
+    static const errno_table table = []() -> errno_table {
+        errno_table result{};
+        std::string message{};
+        for (int errsv = 0; errsv < errno_table_size; ++errsv)
+        {
+            strerror_copy(errsv, message);
+            result.offsets[static_cast<std::size_t>(errsv)] = result.messages.size();
+            result.messages.append(message);
+        }
+        result.offsets[errno_table_size] = result.messages.size();
+        return result;
+    }();
+    return table;
+}
+
+/**
+ * The messages of errno values outside the table, each formatted once on first use.  The map's
+ * nodes don't move when it grows so every view handed out stays valid.
+ */
+CHAIN_INLINE auto errno_message(int errsv) -> std::string_view
+{
+    static std::mutex                           lock{};
+    static std::unordered_map<int, std::string> messages{};
+
+    std::lock_guard<std::mutex> guard{lock};
+    auto [it, inserted] = messages.try_emplace(errsv);
+    if (inserted)
+    {
+        strerror_copy(errsv, it->second);
+    }
+    return it->second;
+}
+} // namespace detail
+
+CHAIN_INLINE auto strerror_view(int errsv) -> std::string_view
+{
+    CHAIN_INSTRUMENT_SCOPE(strerror, 0);
+    if (errsv >= 0 && errsv < detail::errno_table_size)
+    {
+        const auto& table = detail::errno_messages();
+        const auto  index = static_cast<std::size_t>(errsv);
+        const auto  first = table.offsets[index];
+        return std::string_view{table.messages}.substr(first, table.offsets[index + 1] - first);
+    }
+
+    return detail::errno_message(errsv);
+}
+
+CHAIN_INLINE auto strerror(int errsv) -> std::string
+{
+    return std::string{strerror_view(errsv)};
+}
+
+} // namespace chain::str
+
+// Only the implementation selects kernels, don't leak the macro into headers included after it.
+#undef CHAIN_SIMD_X86
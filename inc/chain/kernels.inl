@@ -0,0 +1,252 @@
+// Vectorized kernel bodies, this file is included once per instruction set by chain/chain.inl
+// inside a namespace that defines `ops` and is compiled for that instruction set's target.
+// Every kernel handles full vectors and hands the remainder to its `scalar` counterpart.
+//
+// `ops` provides:
+//   width              Bytes per vector.
+//   full_mask          A mask with all `width` lanes set.
+//   load/store         Unaligned vector loads and stores.
+//   load_partial       Loads fewer than `width` bytes without reading past them, other lanes are 0.
+//   splat              Broadcasts a byte to every lane.
+//   eq_mask            Lane equality as a bitmask, bit i is lane i.
+//   to_lower/to_upper  ASCII case conversion of every lane.
+//   space_mask         Bitmask of the lanes that are ASCII whitespace.
+
+CHAIN_INLINE auto equal_insensitive(const char* left, const char* right, std::size_t n) -> bool
+{
+    std::size_t i = 0;
+    for (; i + ops::width <= n; i += ops::width)
+    {
+        const auto l = ops::to_lower(ops::load(left + i));
+        const auto r = ops::to_lower(ops::load(right + i));
+        if (ops::eq_mask(l, r) != ops::full_mask)
+        {
+            return false;
+        }
+    }
+    return scalar::equal_insensitive(left + i, right + i, n - i);
+}
+
+CHAIN_INLINE auto find_insensitive(const char* data, std::size_t begin, std::size_t end, std::string_view needle)
+    -> std::size_t
+{
+    const std::size_t n     = needle.size();
+    const auto        first = ops::splat(ascii_lower(static_cast<unsigned char>(needle.front())));
+    const auto        last  = ops::splat(ascii_lower(static_cast<unsigned char>(needle.back())));
+
+    std::size_t i = begin;
+    for (; i + ops::width <= end; i += ops::width)
+    {
+        uint64_t mask = ops::eq_mask(ops::to_lower(ops::load(data + i)), first) &
+                        ops::eq_mask(ops::to_lower(ops::load(data + i + n - 1)), last);
+        while (mask != 0)
+        {
+            const auto bit = static_cast<std::size_t>(__builtin_ctzll(mask));
+            if (n <= 2 || equal_insensitive(data + i + bit + 1, needle.data() + 1, n - 2))
+            {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return scalar::find_insensitive(data, i, end, needle);
+}
+
+CHAIN_INLINE auto rfind_insensitive(const char* data, std::size_t end, std::string_view needle) -> std::size_t
+{
+    const std::size_t n     = needle.size();
+    const auto        first = ops::splat(ascii_lower(static_cast<unsigned char>(needle.front())));
+    const auto        last  = ops::splat(ascii_lower(static_cast<unsigned char>(needle.back())));
+
+    for (; end >= ops::width; end -= ops::width)
+    {
+        const std::size_t base = end - ops::width;
+        uint64_t          mask = ops::eq_mask(ops::to_lower(ops::load(data + base)), first) &
+                        ops::eq_mask(ops::to_lower(ops::load(data + base + n - 1)), last);
+        while (mask != 0)
+        {
+            const auto bit = static_cast<std::size_t>(63 - __builtin_clzll(mask));
+            if (n <= 2 || equal_insensitive(data + base + bit + 1, needle.data() + 1, n - 2))
+            {
+                return base + bit;
+            }
+            mask &= ~(uint64_t{1} << bit);
+        }
+    }
+
+    return scalar::rfind_insensitive(data, end, needle);
+}
+
+CHAIN_INLINE auto to_lower(const char* in, char* out, std::size_t n) -> void
+{
+    std::size_t i = 0;
+    for (; i + ops::width <= n; i += ops::width)
+    {
+        ops::store(out + i, ops::to_lower(ops::load(in + i)));
+    }
+    scalar::to_lower(in + i, out + i, n - i);
+}
+
+CHAIN_INLINE auto to_upper(const char* in, char* out, std::size_t n) -> void
+{
+    std::size_t i = 0;
+    for (; i + ops::width <= n; i += ops::width)
+    {
+        ops::store(out + i, ops::to_upper(ops::load(in + i)));
+    }
+    scalar::to_upper(in + i, out + i, n - i);
+}
+
+CHAIN_INLINE auto trim_left(const char* data, std::size_t n) -> std::size_t
+{
+    std::size_t i = 0;
+    for (; i + ops::width <= n; i += ops::width)
+    {
+        const uint64_t kept = ~ops::space_mask(ops::load(data + i)) & ops::full_mask;
+        if (kept != 0)
+        {
+            return i + static_cast<std::size_t>(__builtin_ctzll(kept));
+        }
+    }
+    return i + scalar::trim_left(data + i, n - i);
+}
+
+CHAIN_INLINE auto trim_right(const char* data, std::size_t n) -> std::size_t
+{
+    std::size_t end = n;
+    for (; end >= ops::width; end -= ops::width)
+    {
+        const std::size_t base = end - ops::width;
+        const uint64_t    kept = ~ops::space_mask(ops::load(data + base)) & ops::full_mask;
+        if (kept != 0)
+        {
+            return n - (base + static_cast<std::size_t>(64 - __builtin_clzll(kept)));
+        }
+    }
+    return (n - end) + scalar::trim_right(data, end);
+}
+
+CHAIN_INLINE auto find_all(
+    const char*               data,
+    std::size_t               size,
+    std::string_view          needle,
+    bool                      fold,
+    bool                      overlapping,
+    std::vector<std::size_t>* out) -> std::size_t
+{
+    const std::size_t n          = needle.size();
+    const std::size_t end        = size - n + 1;
+    const auto        first_byte = static_cast<unsigned char>(needle.front());
+    const auto        last_byte  = static_cast<unsigned char>(needle.back());
+    const auto        first      = ops::splat(fold ? ascii_lower(first_byte) : first_byte);
+    const auto        last       = ops::splat(fold ? ascii_lower(last_byte) : last_byte);
+
+    std::size_t found{0};
+    // The lowest start a non-overlapping match may begin at.
+    std::size_t next{0};
+
+    std::size_t i = 0;
+    for (; i + ops::width <= end; i += ops::width)
+    {
+        auto head = ops::load(data + i);
+        if (fold)
+        {
+            head = ops::to_lower(head);
+        }
+        uint64_t mask = ops::eq_mask(head, first);
+
+        if (n == 1 && out == nullptr)
+        {
+            // A single byte can't overlap itself, every candidate is a match.
+            found += static_cast<std::size_t>(__builtin_popcountll(mask));
+            continue;
+        }
+
+        if (n > 1)
+        {
+            auto tail = ops::load(data + i + n - 1);
+            if (fold)
+            {
+                tail = ops::to_lower(tail);
+            }
+            mask &= ops::eq_mask(tail, last);
+        }
+
+        while (mask != 0)
+        {
+            const std::size_t pos = i + static_cast<std::size_t>(__builtin_ctzll(mask));
+            mask &= mask - 1;
+
+            if (pos < next)
+            {
+                continue;
+            }
+
+            const bool middle = (n <= 2) || (fold ? equal_insensitive(data + pos + 1, needle.data() + 1, n - 2)
+                                                  : std::memcmp(data + pos + 1, needle.data() + 1, n - 2) == 0);
+            if (middle)
+            {
+                ++found;
+                if (out != nullptr)
+                {
+                    out->push_back(pos);
+                }
+                if (!overlapping)
+                {
+                    next = pos + n;
+                }
+            }
+        }
+    }
+
+    return found + scalar::find_all_from(data, i, end, needle, fold, overlapping, next, out);
+}
+
+CHAIN_INLINE auto byte_masks(const char* data, std::size_t size, unsigned char c, bool fold, uint64_t* masks) -> void
+{
+    const auto target = ops::splat(c);
+
+    std::size_t i = 0;
+    for (; i + 64 <= size; i += 64)
+    {
+        uint64_t mask{0};
+        for (std::size_t lane = 0; lane < 64; lane += ops::width)
+        {
+            auto block = ops::load(data + i + lane);
+            if (fold)
+            {
+                block = ops::to_lower(block);
+            }
+            mask |= ops::eq_mask(block, target) << lane;
+        }
+        masks[i / 64] = mask;
+    }
+
+    if (i < size)
+    {
+        // The final partial mask takes whole vectors while they fit and a partial vector after that.
+        uint64_t    mask{0};
+        std::size_t lane = 0;
+        for (; i + lane + ops::width <= size; lane += ops::width)
+        {
+            auto block = ops::load(data + i + lane);
+            if (fold)
+            {
+                block = ops::to_lower(block);
+            }
+            mask |= ops::eq_mask(block, target) << lane;
+        }
+        if (i + lane < size)
+        {
+            const std::size_t remaining = size - i - lane;
+            auto              block     = ops::load_partial(data + i + lane, remaining);
+            if (fold)
+            {
+                block = ops::to_lower(block);
+            }
+            mask |= (ops::eq_mask(block, target) & ((uint64_t{1} << remaining) - 1)) << lane;
+        }
+        masks[i / 64] = mask;
+    }
+}
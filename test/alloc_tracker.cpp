@@ -0,0 +1,172 @@
+#include "alloc_tracker.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions for every executable that links this file.  Every
+// form is replaced, sanitizers provide their own array and nothrow forms instead of forwarding
+// them to the scalar ones, which would leave those uncounted and mismatched with `deallocate`.
+
+namespace chain::alloc_tracker
+{
+namespace
+{
+// Constant initialized so operator new can use it before any dynamic initialization has run.
+thread_local counts g_counts;
+} // namespace
+
+auto thread_counts() -> counts
+{
+    return g_counts;
+}
+
+} // namespace chain::alloc_tracker
+
+namespace
+{
+/**
+ * @return The allocation, or nullptr when it fails.
+ */
+auto allocate_nothrow(std::size_t size, std::size_t alignment) noexcept -> void*
+{
+    auto& tracked = chain::alloc_tracker::g_counts;
+    ++tracked.allocations;
+    tracked.bytes += size;
+
+    if (size == 0)
+    {
+        size = 1;
+    }
+
+    void* ptr{nullptr};
+    if (alignment <= alignof(std::max_align_t))
+    {
+        ptr = std::malloc(size);
+    }
+    else
+    {
+        // aligned_alloc requires the size to be a multiple of the alignment.
+        ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+    return ptr;
+}
+
+auto allocate(std::size_t size, std::size_t alignment) -> void*
+{
+    void* ptr = allocate_nothrow(size, alignment);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+
+auto deallocate(void* ptr) -> void
+{
+    if (ptr != nullptr)
+    {
+        ++chain::alloc_tracker::g_counts.deallocations;
+        std::free(ptr);
+    }
+}
+} // namespace
+
+auto operator new(std::size_t size) -> void*
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+auto operator new[](std::size_t size) -> void*
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void*
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void*
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new(std::size_t size, const std::nothrow_t&) noexcept -> void*
+{
+    return allocate_nothrow(size, alignof(std::max_align_t));
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t&) noexcept -> void*
+{
+    return allocate_nothrow(size, alignof(std::max_align_t));
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept -> void*
+{
+    return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept -> void*
+{
+    return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator delete(void* ptr) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete[](void* ptr) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete(void* ptr, std::align_val_t) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete[](void* ptr, std::align_val_t) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete[](void* ptr, std::size_t) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t, std::align_val_t) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete(void* ptr, const std::nothrow_t&) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete[](void* ptr, const std::nothrow_t&) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept -> void
+{
+    deallocate(ptr);
+}
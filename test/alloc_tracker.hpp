@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace chain::alloc_tracker
+{
+/**
+ * Heap activity of one thread.  Only executables that link the `chain_alloc_tracker` target
+ * have their global operator new and operator delete replaced to record it.
+ */
+struct counts
+{
+    /// Calls to any form of operator new.
+    std::size_t allocations{0};
+    /// Calls to any form of operator delete with a non null pointer.
+    std::size_t deallocations{0};
+    /// The bytes requested by `allocations`.
+    std::size_t bytes{0};
+};
+
+/**
+ * @return The heap activity of the calling thread since it started.
+ */
+auto thread_counts() -> counts;
+
+/**
+ * @param functor Called once on this thread.
+ * @return The heap activity of the calling thread during `functor()`, other threads aren't counted.
+ */
+template<typename functor_type>
+auto count(functor_type&& functor) -> counts
+{
+    const auto before = thread_counts();
+    std::forward<functor_type>(functor)();
+    const auto after = thread_counts();
+    return counts{
+        after.allocations - before.allocations, after.deallocations - before.deallocations, after.bytes - before.bytes};
+}
+
+} // namespace chain::alloc_tracker
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "alloc_tracker.hpp"
+#include "catch.hpp"
+
+/**
+ * Requires the expression to allocate at most `max` times.  The expression is evaluated once
+ * untimed first so lazily initialized state, e.g. thread local scratch buffers and the SIMD
+ * dispatch, isn't attributed to it, then once more while counting.
+ */
+#define REQUIRE_ALLOCATIONS_AT_MOST(max, ...)                                                                    \
+    do                                                                                                           \
+    {                                                                                                            \
+        (void)(__VA_ARGS__);                                                                                     \
+        const auto chain_counted_ = chain::alloc_tracker::count([&]() { (void)(__VA_ARGS__); });               \
+        INFO(#__VA_ARGS__ << " allocated " << chain_counted_.allocations << " times");                           \
+        REQUIRE(chain_counted_.allocations <= static_cast<std::size_t>(max));                                    \
+    } while (false)
+
+/**
+ * Requires the expression not to allocate, see `REQUIRE_ALLOCATIONS_AT_MOST`.
+ */
+#define REQUIRE_NO_ALLOCATIONS(...) REQUIRE_ALLOCATIONS_AT_MOST(0, __VA_ARGS__)
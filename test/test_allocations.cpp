@@ -0,0 +1,258 @@
+#include "catch.hpp"
+#include "require_allocations.hpp"
+
+#include <chain/chain.hpp>
+
+#include <array>
+#include <cerrno>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// The functions documented as not copying or not allocating, their results are views into the
+// input or written into caller provided buffers that are already large enough.
+
+TEST_CASE("allocation tracker counts this thread's heap activity")
+{
+    using namespace chain;
+
+    auto counted = alloc_tracker::count([]() {
+        auto value = std::make_unique<int>(1);
+        auto array = std::make_unique<int[]>(4);
+        REQUIRE(*value + array[0] == 1);
+    });
+    REQUIRE(counted.allocations == 2);
+    REQUIRE(counted.deallocations == 2);
+    REQUIRE(counted.bytes >= sizeof(int) * 5);
+
+    REQUIRE_NO_ALLOCATIONS(1 + 1);
+    REQUIRE_ALLOCATIONS_AT_MOST(1, std::string(64, 'x'));
+}
+
+TEST_CASE("search functions don't allocate")
+{
+    using namespace chain::str;
+
+    const std::string data{"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor"};
+    const std::string upper{to_upper_copy(data)};
+
+    REQUIRE_NO_ALLOCATIONS(equal(data, data));
+    REQUIRE_NO_ALLOCATIONS(equal<case_t::insensitive>(data, upper));
+    REQUIRE_NO_ALLOCATIONS(starts_with<case_t::insensitive>(data, "LOREM"));
+    REQUIRE_NO_ALLOCATIONS(ends_with<case_t::insensitive>(data, "TEMPOR"));
+    REQUIRE_NO_ALLOCATIONS(find(data, "tempor"));
+    REQUIRE_NO_ALLOCATIONS(find<case_t::insensitive>(data, "TEMPOR"));
+    REQUIRE_NO_ALLOCATIONS(rfind<case_t::insensitive>(data, "LOREM"));
+    REQUIRE_NO_ALLOCATIONS(count<case_t::insensitive>(data, "O"));
+
+    const searcher<case_t::insensitive> compiled{"DOLOR"};
+    REQUIRE_NO_ALLOCATIONS(compiled.find(data));
+    REQUIRE_NO_ALLOCATIONS(compiled.rfind(data));
+    REQUIRE_NO_ALLOCATIONS(compiled.count(data));
+
+    std::vector<std::size_t> positions{};
+    positions.reserve(data.size());
+    REQUIRE_NO_ALLOCATIONS((positions.clear(), find_all<case_t::insensitive>(data, "O", positions)));
+
+    const multi_searcher<case_t::insensitive> many{{"IPSUM", "ELIT", "SED"}};
+    REQUIRE_NO_ALLOCATIONS(many.find_any(data));
+    std::vector<multi_searcher<case_t::insensitive>::match> matches{};
+    matches.reserve(16);
+    REQUIRE_NO_ALLOCATIONS((matches.clear(), many.find_all(data, matches)));
+}
+
+TEST_CASE("split functions don't copy the data")
+{
+    using namespace chain::str;
+
+    const std::string data{"1,-2,3.5,four,  5  ,,6"};
+
+    std::vector<std::string_view> parts{};
+    parts.reserve(16);
+    REQUIRE_NO_ALLOCATIONS((parts.clear(), split(data, ',', parts)));
+    REQUIRE_NO_ALLOCATIONS((parts.clear(), split(data, ",", parts)));
+    REQUIRE_NO_ALLOCATIONS((parts.clear(), split<case_t::insensitive>(data, "FOUR", parts)));
+
+    const searcher<case_t::sensitive> delim{","};
+    REQUIRE_NO_ALLOCATIONS((parts.clear(), split(data, delim, parts)));
+
+    std::size_t n{0};
+    REQUIRE_NO_ALLOCATIONS(split_for_each(data, ',', [&](std::string_view) { ++n; }));
+    REQUIRE_NO_ALLOCATIONS(split_for_each(data, ",", [&](std::string_view) { ++n; }));
+    REQUIRE_NO_ALLOCATIONS(split_for_each(data, delim, [&](std::string_view) { ++n; }));
+    REQUIRE(n > 0);
+
+    REQUIRE_NO_ALLOCATIONS([&]() {
+        std::size_t size{0};
+        for (auto part : split_view{data, ','})
+        {
+            size += part.size();
+        }
+        return size;
+    }());
+
+    int64_t          id{0};
+    std::string_view name{};
+    double           price{0.0};
+    REQUIRE_NO_ALLOCATIONS(split_into("42,widget,9.5", ',', id, name, price));
+    REQUIRE_NO_ALLOCATIONS(split_as<int64_t, std::string_view, double>("42,widget,9.5", ','));
+}
+
+TEST_CASE("join into warmed up buffers doesn't allocate")
+{
+    using namespace chain::str;
+
+    const std::vector<std::string_view> parts{"herp", "derp", "cherp"};
+    const std::vector<int64_t>          numbers{1, -22, 333};
+    const std::vector<double>           values{1.5, -0.25};
+
+    std::string out{};
+    out.reserve(64);
+    REQUIRE_NO_ALLOCATIONS((out.clear(), join_into(out, parts, ", ")));
+    REQUIRE_NO_ALLOCATIONS((out.clear(), join_into(out, numbers, ',')));
+    REQUIRE_NO_ALLOCATIONS((out.clear(), join_into(out, values, ',')));
+    REQUIRE_NO_ALLOCATIONS((out.clear(), map_join_into(out, parts, ',', [](std::string_view p) { return p.size(); })));
+
+    std::array<char, 64> buffer{};
+    REQUIRE_NO_ALLOCATIONS(join_into(buffer.data(), buffer.size(), parts, ','));
+    REQUIRE_NO_ALLOCATIONS(join_into(buffer.data(), buffer.size(), numbers, ','));
+
+    // The returning versions allocate the result once.
+    REQUIRE_ALLOCATIONS_AT_MOST(1, join(parts, ", "));
+    REQUIRE_ALLOCATIONS_AT_MOST(1, join(numbers, ','));
+}
+
+TEST_CASE("trim and case conversion views and in place versions don't allocate")
+{
+    using namespace chain::str;
+
+    const std::string data{" \t Lorem Ipsum Dolor \r\n"};
+
+    REQUIRE_NO_ALLOCATIONS(trim_view(data));
+    REQUIRE_NO_ALLOCATIONS(trim_left_view(data));
+    REQUIRE_NO_ALLOCATIONS(trim_right_view(data));
+    REQUIRE_NO_ALLOCATIONS(trim_view<case_t::insensitive>("xXxherpXx", "x"));
+
+    std::string copy{data};
+    REQUIRE_NO_ALLOCATIONS(trim(copy));
+    REQUIRE_NO_ALLOCATIONS(to_lower(copy));
+    REQUIRE_NO_ALLOCATIONS(to_upper(copy));
+
+    std::array<char, 64> buffer{};
+    REQUIRE_NO_ALLOCATIONS(to_lower_ascii(data, buffer.data()));
+    REQUIRE_NO_ALLOCATIONS(to_upper_ascii(data, buffer.data()));
+
+    // A copy longer than the small string buffer allocates once.
+    REQUIRE_ALLOCATIONS_AT_MOST(1, to_lower_copy(data));
+    REQUIRE_ALLOCATIONS_AT_MOST(1, to_upper_copy(data));
+}
+
+TEST_CASE("replace in place doesn't allocate")
+{
+    using namespace chain::str;
+
+    // Every expression restores `data` first, it's evaluated twice and only the second run is
+    // counted.  Assigning the original back fits the reserved capacity.
+    const std::string original{"herp derp cherp merp derp derp herp derp cherp merp derp derp"};
+    std::string       data{original};
+    data.reserve(data.size() * 4);
+
+    REQUIRE_NO_ALLOCATIONS((data = original, replace(data, "derp", "ferp")));
+    REQUIRE(data == "herp ferp cherp merp ferp ferp herp ferp cherp merp ferp ferp");
+    REQUIRE_NO_ALLOCATIONS((data = original, replace<case_t::insensitive>(data, "DERP", "ferp")));
+
+    // Shrinking rewrites the string in place.
+    REQUIRE_NO_ALLOCATIONS((data = original, replace(data, "derp", "dp")));
+    REQUIRE_NO_ALLOCATIONS((data = original, replace(data, "derp", "d")));
+
+    // Growing fits the reserved capacity, matches are recorded in a reused thread local buffer.
+    REQUIRE_NO_ALLOCATIONS((data = original, replace(data, "d", "derp")));
+    REQUIRE_NO_ALLOCATIONS((data = original, replace(data, "d", "derp"), replace(data, "derp", "d")));
+    REQUIRE(data == original);
+
+    const searcher<case_t::sensitive> from{"herp"};
+    REQUIRE_NO_ALLOCATIONS((data = original, replace(data, from, "kerp")));
+
+    // Every match is substituted in one pass into a single new string.
+    const multi_searcher<case_t::sensitive> table{{"kerp", "herp"}};
+    const std::vector<std::string_view>     to{"herp", "kerp"};
+    REQUIRE_ALLOCATIONS_AT_MOST(1, (data = original, replace_all(data, table, to)));
+
+    // The copy is made once and the replacement fits it or it's copied once more.
+    REQUIRE_ALLOCATIONS_AT_MOST(2, replace_copy(data, "d", "derp"));
+
+    stream_replacer<case_t::sensitive> replacer{"derp", "ferp"};
+    std::size_t                        written{0};
+    auto                               sink = [&](std::string_view out) { written += out.size(); };
+    REQUIRE_NO_ALLOCATIONS(replacer.write(data, sink));
+    REQUIRE_NO_ALLOCATIONS(replacer.finish(sink));
+}
+
+TEST_CASE("replace doesn't keep a large match buffer")
+{
+    using namespace chain;
+
+    // On a new thread the reused match buffers start empty, everything a large growing replace
+    // allocates besides its output is freed before it returns.
+    std::string           data(100000, 'a');
+    std::string           replaced(100000, 'a');
+    alloc_tracker::counts counted{};
+    alloc_tracker::counts counted_all{};
+    std::thread worker{[&]() {
+        counted = alloc_tracker::count([&]() { str::replace(data, "a", "bb"); });
+
+        const str::multi_searcher<str::case_t::sensitive> table{{"a"}};
+        const std::vector<std::string_view>               to{"bb"};
+        counted_all = alloc_tracker::count([&]() { str::replace_all(replaced, table, to); });
+    }};
+    worker.join();
+
+    REQUIRE(data.size() == 200000);
+    REQUIRE(counted.allocations == counted.deallocations);
+    REQUIRE(replaced.size() == 200000);
+    REQUIRE(counted_all.allocations == counted_all.deallocations);
+}
+
+TEST_CASE("chain pipeline allocates only its output")
+{
+    using namespace chain::str;
+
+    const std::string data{"  Lorem Ipsum Dolor Sit Amet, Consectetur Adipiscing Elit, Sed Do Eiusmod Tempor  "};
+
+    auto p = chain::str::chain(data).trim().lower().replace("ipsum", "herp").replace("tempor", "derp");
+    REQUIRE_ALLOCATIONS_AT_MOST(1, p.str());
+    REQUIRE_NO_ALLOCATIONS(p.split_for_each(',', [](std::string_view) {}));
+}
+
+TEST_CASE("number parsing doesn't allocate")
+{
+    using namespace chain::str;
+
+    REQUIRE_NO_ALLOCATIONS(to_number<int64_t>("-9223372036854775808"));
+    REQUIRE_NO_ALLOCATIONS(to_number<uint64_t>("18446744073709551615"));
+    REQUIRE_NO_ALLOCATIONS(to_number<int>("ff", 16));
+    REQUIRE_NO_ALLOCATIONS(to_number<double>("-1.25e-300"));
+    REQUIRE_NO_ALLOCATIONS(to_number<double>("  +0x1.8p3"));
+    REQUIRE_NO_ALLOCATIONS(to_number<float>("3.4028235e38"));
+    REQUIRE_NO_ALLOCATIONS(classify_number("-12.5e3"));
+    REQUIRE_NO_ALLOCATIONS(is_int("12345678901234567890"));
+    REQUIRE_NO_ALLOCATIONS(is_float("12345678901234567890.5"));
+    REQUIRE_NO_ALLOCATIONS(is_number("0x12345678901234567890"));
+
+    const std::vector<std::string_view> fields{"1", "-2", "33333333333333333", "x", "+5"};
+    std::vector<std::optional<int64_t>> values{};
+    values.reserve(fields.size());
+    REQUIRE_NO_ALLOCATIONS((values.clear(), to_numbers<int64_t>(fields, values)));
+}
+
+TEST_CASE("strerror_view doesn't allocate")
+{
+    using namespace chain::str;
+
+    REQUIRE_NO_ALLOCATIONS(strerror_view(EAGAIN));
+    REQUIRE_NO_ALLOCATIONS(strerror_view(ENOENT));
+    REQUIRE_NO_ALLOCATIONS(strerror_view(100000));
+}
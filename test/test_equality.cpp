@@ -78,3 +78,26 @@ TEST_CASE("ends_with longer end")
 {
     REQUIRE_FALSE(chain::str::ends_with("a", "Ab"));
 }
+
+TEST_CASE("equal, starts_with and ends_with at compile time")
+{
+    using namespace chain::str;
+
+    static_assert(equal("herp", "herp"));
+    static_assert(!equal("herp", "HERP"));
+    static_assert(equal<case_t::insensitive>("herp", "HERP"));
+    static_assert(!equal<case_t::insensitive>("herp", "HERPS"));
+    static_assert(equal_uchar<case_t::insensitive>('a', 'A'));
+    static_assert(starts_with("Content-Type: text/html", "Content-Type"));
+    static_assert(starts_with<case_t::insensitive>("Content-Type: text/html", "content-type"));
+    static_assert(!starts_with("a", "ab"));
+    static_assert(ends_with<case_t::insensitive>("index.HTML", ".html"));
+    static_assert(!ends_with("index.HTML", ".html"));
+    static_assert(!ends_with("a", "ba"));
+
+    // The same results at run time with the SIMD kernels.
+    const std::string runtime{"Content-Type: text/html"};
+    REQUIRE(starts_with<case_t::insensitive>(runtime, "content-type"));
+    REQUIRE(ends_with<case_t::insensitive>(runtime, "TEXT/HTML"));
+    REQUIRE_FALSE(ends_with<case_t::insensitive>(runtime, "TEXT/HTM"));
+}
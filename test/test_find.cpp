@@ -62,3 +62,196 @@ TEST_CASE("rfind insensitive")
     REQUIRE(rfind<case_t::insensitive>("derpaaaaaaaaaaaaaaaaaderp", "DERP", 22) == 0);
     REQUIRE(rfind<case_t::insensitive>("derpaaaaaaaaaaaaaaaaaderp", "DERP", 20) == 0);
 }
+
+TEST_CASE("find insensitive long haystack")
+{
+    using namespace chain::str;
+    // Long enough to exercise every vector width plus a scalar tail.
+    std::string haystack(1000, 'x');
+    haystack.replace(3, 4, "DeRp");
+    haystack.replace(517, 4, "dErP");
+    haystack.replace(994, 4, "DERP");
+
+    REQUIRE(find<case_t::insensitive>(haystack, "derp") == 3);
+    REQUIRE(find<case_t::insensitive>(haystack, "derp", 4) == 517);
+    REQUIRE(find<case_t::insensitive>(haystack, "derp", 518) == 994);
+    REQUIRE(find<case_t::insensitive>(haystack, "derp", 995) == std::string_view::npos);
+    REQUIRE(find<case_t::insensitive>(haystack, "d", 4) == 517);
+    REQUIRE(find<case_t::insensitive>(haystack, "dp") == std::string_view::npos);
+    REQUIRE(find<case_t::insensitive>(haystack, std::string(64, 'X')) == 7);
+    REQUIRE(find<case_t::insensitive>(haystack, "Xd", 4) == 516);
+    REQUIRE(find<case_t::insensitive>(haystack, "") == 0);
+    REQUIRE(find<case_t::insensitive>(haystack, "derp", 1001) == std::string_view::npos);
+}
+
+TEST_CASE("rfind insensitive long haystack")
+{
+    using namespace chain::str;
+    std::string haystack(1000, 'x');
+    haystack.replace(3, 4, "DeRp");
+    haystack.replace(517, 4, "dErP");
+    haystack.replace(994, 4, "DERP");
+
+    REQUIRE(rfind<case_t::insensitive>(haystack, "derp") == 994);
+    REQUIRE(rfind<case_t::insensitive>(haystack, "derp", 997) == 517);
+    REQUIRE(rfind<case_t::insensitive>(haystack, "derp", 520) == 3);
+    REQUIRE(rfind<case_t::insensitive>(haystack, "derp", 6) == std::string_view::npos);
+    REQUIRE(rfind<case_t::insensitive>(haystack, "p", 520) == 6);
+    REQUIRE(rfind<case_t::insensitive>(haystack, std::string(64, 'X')) == 930);
+    REQUIRE(rfind<case_t::insensitive>(haystack, "pX") == 997);
+}
+
+TEST_CASE("find and rfind insensitive match a reference search")
+{
+    using namespace chain::str;
+    // Non alpha bytes adjacent to the ASCII letter ranges must not fold.
+    std::string alphabet = "aAzZ@[`{\xC1\xE1 derpDERP";
+    std::string haystack{};
+    for (std::size_t i = 0; i < 300; ++i)
+    {
+        haystack.push_back(alphabet[(i * 7 + i / 13) % alphabet.size()]);
+    }
+
+    auto reference_find = [&](std::string_view needle, std::size_t pos) -> std::size_t {
+        for (std::size_t i = pos; i + needle.size() <= haystack.size(); ++i)
+        {
+            if (equal<case_t::insensitive>(std::string_view{haystack}.substr(i, needle.size()), needle))
+            {
+                return i;
+            }
+        }
+        return std::string_view::npos;
+    };
+
+    auto reference_rfind = [&](std::string_view needle, std::size_t pos) -> std::size_t {
+        for (std::size_t end = std::min(pos, haystack.size()); end >= needle.size(); --end)
+        {
+            const auto candidate = std::string_view{haystack}.substr(end - needle.size(), needle.size());
+            if (equal<case_t::insensitive>(candidate, needle))
+            {
+                return end - needle.size();
+            }
+        }
+        return std::string_view::npos;
+    };
+
+    for (std::size_t start = 0; start + 3 < haystack.size(); start += 11)
+    {
+        for (std::size_t length = 1; length <= 3; ++length)
+        {
+            std::string needle = haystack.substr(start, length);
+            to_upper(needle);
+            for (std::size_t pos = 0; pos < haystack.size(); pos += 37)
+            {
+                REQUIRE(find<case_t::insensitive>(haystack, needle, pos) == reference_find(needle, pos));
+                REQUIRE(rfind<case_t::insensitive>(haystack, needle, pos) == reference_rfind(needle, pos));
+            }
+        }
+    }
+}
+
+TEST_CASE("count sensitive")
+{
+    using namespace chain::str;
+    REQUIRE(count("a,b,,c", ",") == 3);
+    REQUIRE(count("a,b,,c", ",,") == 1);
+    REQUIRE(count("derpDERPderp", "derp") == 2);
+    REQUIRE(count("aaaa", "aa") == 2);
+    REQUIRE(count<case_t::sensitive, overlap_t::overlapping>("aaaa", "aa") == 3);
+    REQUIRE(count("abc", "") == 0);
+    REQUIRE(count("abc", "abcd") == 0);
+    REQUIRE(count("", "a") == 0);
+}
+
+TEST_CASE("count insensitive")
+{
+    using namespace chain::str;
+    REQUIRE(count<case_t::insensitive>("derpDERPdErP", "DeRp") == 3);
+    REQUIRE(count<case_t::insensitive>("aAaA", "a") == 4);
+    REQUIRE(count<case_t::insensitive>("@`[{", "@") == 1);
+    REQUIRE(count<case_t::insensitive, overlap_t::overlapping>("AaAa", "aa") == 3);
+}
+
+TEST_CASE("find_all")
+{
+    using namespace chain::str;
+    REQUIRE(find_all("a,b,,c", ",") == std::vector<std::size_t>{1, 3, 4});
+    REQUIRE(find_all("aaaa", "aa") == std::vector<std::size_t>{0, 2});
+    REQUIRE(find_all<case_t::sensitive, overlap_t::overlapping>("aaaa", "aa") == std::vector<std::size_t>{0, 1, 2});
+    REQUIRE(find_all<case_t::insensitive>("xABx abx", "ab") == std::vector<std::size_t>{1, 5});
+
+    std::vector<std::size_t> out{42};
+    find_all("abab", "b", out);
+    REQUIRE(out == std::vector<std::size_t>{42, 1, 3});
+}
+
+TEST_CASE("count and find_all long haystack at every simd_level")
+{
+    using namespace chain::str;
+    const auto original = active_simd_level();
+
+    std::string haystack{};
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        haystack.push_back("aAb,"[(i * i + i / 3) % 4]);
+    }
+
+    for (auto level : {simd_level::scalar, simd_level::sse2, simd_level::avx2, simd_level::avx512})
+    {
+        force_simd_level(level);
+
+        for (std::string_view needle : {",", "a", "aa", "aA", "a,b", "Ab,aA", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"})
+        {
+            std::size_t non_overlapping{0};
+            for (std::size_t pos = 0; (pos = find(haystack, needle, pos)) != std::string_view::npos;
+                 pos += needle.size())
+            {
+                ++non_overlapping;
+            }
+
+            std::vector<std::size_t> overlapping{};
+            for (std::size_t pos = 0;
+                 (pos = find<case_t::insensitive>(haystack, needle, pos)) != std::string_view::npos;
+                 ++pos)
+            {
+                overlapping.push_back(pos);
+            }
+
+            REQUIRE(count(haystack, needle) == non_overlapping);
+            REQUIRE(find_all(haystack, needle).size() == non_overlapping);
+            REQUIRE(count<case_t::insensitive, overlap_t::overlapping>(haystack, needle) == overlapping.size());
+            REQUIRE(find_all<case_t::insensitive, overlap_t::overlapping>(haystack, needle) == overlapping);
+        }
+    }
+
+    force_simd_level(original);
+}
+
+TEST_CASE("find and rfind at compile time")
+{
+    using namespace chain::str;
+
+    static_assert(find("herp derp", "derp") == 5);
+    static_assert(find("herp derp", "DERP") == std::string_view::npos);
+    static_assert(find<case_t::insensitive>("herp derp", "DERP") == 5);
+    static_assert(find<case_t::insensitive>("herp derp herp", "HERP", 1) == 10);
+    static_assert(find<case_t::insensitive>("herp", "", 4) == std::string_view::npos);
+    static_assert(rfind<case_t::insensitive>("herp derp herp", "HERP") == 10);
+    static_assert(rfind<case_t::insensitive>("herp derp herp", "HERP", 13) == 0);
+    static_assert(rfind<case_t::insensitive>("herp", "HERPS") == std::string_view::npos);
+
+    // The compile time engines match the run time ones.
+    const std::string_view haystack{"aAbBaAbBcCaA"};
+    for (std::string_view needle : {"", "a", "AB", "bba", "cCa", "aabbaabbccaa", "x"})
+    {
+        for (std::size_t pos = 0; pos <= haystack.size() + 1; ++pos)
+        {
+            REQUIRE(
+                find<case_t::insensitive>(haystack, needle, pos) ==
+                chain::str::detail::constant::find_insensitive(haystack, needle, pos));
+            REQUIRE(
+                rfind<case_t::insensitive>(haystack, needle, pos) ==
+                chain::str::detail::constant::rfind_insensitive(haystack, needle, pos));
+        }
+    }
+}
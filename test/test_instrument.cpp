@@ -0,0 +1,228 @@
+#include "catch.hpp"
+
+#include <chain/chain.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Built into the regular tests where CHAIN_INSTRUMENT is usually off, and into a separate test
+// executable with it on.
+
+namespace
+{
+auto delta(const chain::str::instrument::snapshot& after,
+           const chain::str::instrument::snapshot& before,
+           chain::str::instrument::function        f) -> chain::str::instrument::function_stats
+{
+    auto stats = after[f];
+    stats.calls -= before[f].calls;
+    stats.bytes -= before[f].bytes;
+    stats.total_ns -= before[f].total_ns;
+    for (std::size_t i = 0; i < stats.latency.size(); ++i)
+    {
+        stats.latency[i] -= before[f].latency[i];
+    }
+    return stats;
+}
+
+auto latency_calls(const chain::str::instrument::function_stats& stats) -> uint64_t
+{
+    return std::accumulate(stats.latency.begin(), stats.latency.end(), uint64_t{0});
+}
+} // namespace
+
+TEST_CASE("instrument function names")
+{
+    using namespace chain::str;
+
+    REQUIRE(instrument::to_string(instrument::function::find) == "find");
+    REQUIRE(instrument::to_string(instrument::function::replace_all) == "replace_all");
+    REQUIRE(instrument::to_string(instrument::function::strerror) == "strerror");
+    REQUIRE(instrument::to_string(instrument::function::count) == "unknown");
+}
+
+TEST_CASE("instrument snapshot merge")
+{
+    using namespace chain::str;
+
+    instrument::snapshot left{};
+    instrument::snapshot right{};
+    left.functions[0].calls       = 2;
+    left.functions[0].latency[3]  = 2;
+    right.functions[0].calls      = 3;
+    right.functions[0].bytes      = 10;
+    right.functions[0].latency[3] = 1;
+    right.functions[0].latency[4] = 2;
+
+    left.merge(right);
+    REQUIRE(left.functions[0].calls == 5);
+    REQUIRE(left.functions[0].bytes == 10);
+    REQUIRE(left.functions[0].latency[3] == 3);
+    REQUIRE(left.functions[0].latency[4] == 2);
+    REQUIRE(left.functions[1].calls == 0);
+}
+
+TEST_CASE("instrument records nothing when disabled")
+{
+    using namespace chain::str;
+
+    if (instrument::enabled)
+    {
+        return;
+    }
+
+    std::string data{"  herp derp  "};
+    trim(data);
+    REQUIRE(find(data, "derp") == 5);
+
+    for (const auto& stats : instrument::thread_snapshot().functions)
+    {
+        REQUIRE(stats.calls == 0);
+    }
+    for (const auto& stats : instrument::global_snapshot().functions)
+    {
+        REQUIRE(stats.calls == 0);
+    }
+}
+
+TEST_CASE("instrument records calls, bytes and latency")
+{
+    using namespace chain::str;
+    using instrument::function;
+
+    if (!instrument::enabled)
+    {
+        return;
+    }
+
+    const std::string data{"herp,derp,cherp"};
+    const auto        before = instrument::thread_snapshot();
+
+    REQUIRE(find(data, "derp") == 5);
+    REQUIRE(find<case_t::insensitive>(data, "CHERP") == 10);
+    REQUIRE(rfind(data, "herp") == 11);
+    REQUIRE(to_number<int64_t>("12345") == 12345);
+    REQUIRE(to_number<double>("1.5") == 1.5);
+    REQUIRE(classify_number("1e5").kind == number_class::exponent);
+    REQUIRE(strerror_view(EAGAIN) == "Resource temporarily unavailable");
+
+    auto after = instrument::thread_snapshot();
+
+    auto finds = delta(after, before, function::find);
+    REQUIRE(finds.calls == 2);
+    REQUIRE(finds.bytes == data.size() * 2);
+    REQUIRE(latency_calls(finds) == 2);
+
+    REQUIRE(delta(after, before, function::rfind).calls == 1);
+    REQUIRE(delta(after, before, function::to_number).calls == 2);
+    REQUIRE(delta(after, before, function::to_number).bytes == 8);
+    REQUIRE(delta(after, before, function::classify_number).calls == 1);
+    REQUIRE(delta(after, before, function::strerror).calls == 1);
+    REQUIRE(delta(after, before, function::replace).calls == 0);
+}
+
+TEST_CASE("instrument records nested library calls once")
+{
+    using namespace chain::str;
+    using instrument::function;
+
+    if (!instrument::enabled)
+    {
+        return;
+    }
+
+    const auto before = instrument::thread_snapshot();
+
+    // replace finds each match and split_for_each calls to_number from its functor, only the
+    // outer calls are recorded.
+    std::string data{"herp derp herp derp"};
+    REQUIRE(replace(data, "derp", "ferp") == 2);
+
+    int64_t sum{0};
+    split_for_each("1,2,3", ',', [&](std::string_view part) { sum += to_number<int64_t>(part).value_or(0); });
+    REQUIRE(sum == 6);
+
+    const std::vector<std::string_view> parts{"herp", "derp"};
+    REQUIRE(join(parts, ", ") == "herp, derp");
+
+    auto after = instrument::thread_snapshot();
+    REQUIRE(delta(after, before, function::replace).calls == 1);
+    REQUIRE(delta(after, before, function::replace).bytes == 19);
+    REQUIRE(delta(after, before, function::find).calls == 0);
+    REQUIRE(delta(after, before, function::split).calls == 1);
+    REQUIRE(delta(after, before, function::to_number).calls == 0);
+    REQUIRE(delta(after, before, function::join).calls == 1);
+    REQUIRE(delta(after, before, function::join).bytes == 10);
+}
+
+TEST_CASE("instrument chain pipeline steps stop with an early split")
+{
+    using namespace chain::str;
+    using instrument::function;
+
+    if (!instrument::enabled)
+    {
+        return;
+    }
+
+    std::string data(1 << 20, 'A');
+    data[10] = ',';
+
+    const auto  before = instrument::thread_snapshot();
+    std::size_t calls{0};
+    chain::str::chain(data).lower().split_for_each(',', [&](std::string_view) {
+        ++calls;
+        return false;
+    });
+    REQUIRE(calls == 1);
+
+    // Only the first block of `data` was converted, not the whole input.
+    const auto lowered = delta(instrument::thread_snapshot(), before, function::to_lower);
+    REQUIRE(lowered.bytes > 0);
+    REQUIRE(lowered.bytes <= 4096);
+}
+
+TEST_CASE("instrument global snapshot includes exited threads")
+{
+    using namespace chain::str;
+    using instrument::function;
+
+    if (!instrument::enabled)
+    {
+        return;
+    }
+
+    const auto        before = instrument::global_snapshot();
+    const auto        local  = instrument::thread_snapshot();
+    const std::size_t threads{4};
+    const std::size_t calls{100};
+
+    std::vector<std::thread> workers{};
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&]() {
+            for (std::size_t i = 0; i < calls; ++i)
+            {
+                std::string data{"  herp  "};
+                trim(data);
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    auto after = instrument::global_snapshot();
+    auto trims = delta(after, before, function::trim);
+    REQUIRE(trims.calls == threads * calls);
+    REQUIRE(trims.bytes == threads * calls * 8);
+    REQUIRE(latency_calls(trims) == threads * calls);
+
+    // The other threads' calls are not this thread's.
+    REQUIRE(delta(instrument::thread_snapshot(), local, function::trim).calls == 0);
+}
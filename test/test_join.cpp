@@ -2,6 +2,10 @@
 
 #include <chain/chain.hpp>
 
+#include <array>
+#include <limits>
+#include <sstream>
+#include <string>
 #include <vector>
 
 TEST_CASE("join csv")
@@ -45,3 +49,101 @@ TEST_CASE("map_join no parts")
     auto                 joined = chain::str::map_join(parts, ',', [](int64_t x) { return x * x; });
     REQUIRE(joined.empty());
 }
+
+TEST_CASE("join strings")
+{
+    std::vector<std::string> parts{"alpha", "", "gamma"};
+    REQUIRE(chain::str::join(parts, ", ") == "alpha, , gamma");
+
+    std::vector<std::string_view> views{"a", "b"};
+    REQUIRE(chain::str::join(views, '/') == "a/b");
+
+    std::vector<const char*> literals{"x", "yz"};
+    REQUIRE(chain::str::join(literals, "") == "xyz");
+
+    std::vector<std::string> single{"only"};
+    REQUIRE(chain::str::join(single, ',') == "only");
+}
+
+TEST_CASE("join matches stream formatting")
+{
+    std::vector<double> doubles{0.1, 1.0 / 3.0, 1e21, -2.5, 123456789.0, 0.0};
+    std::vector<float>  floats{0.25f, 1e-7f};
+    std::vector<char>   chars{'a', 'b'};
+    std::vector<bool>   bools{true, false};
+    std::vector<int8_t> small{-1, 65};
+
+    auto streamed = [](const auto& parts, std::string_view delim) {
+        std::stringstream ss{};
+        bool              first{true};
+        for (const auto& part : parts)
+        {
+            if (!first)
+            {
+                ss << delim;
+            }
+            first = false;
+            ss << part;
+        }
+        return ss.str();
+    };
+
+    REQUIRE(chain::str::join(doubles, ',') == streamed(doubles, ","));
+    REQUIRE(chain::str::join(floats, ',') == streamed(floats, ","));
+    REQUIRE(chain::str::join(chars, ',') == streamed(chars, ","));
+    REQUIRE(chain::str::join(bools, ',') == streamed(bools, ","));
+    REQUIRE(chain::str::join(small, ',') == streamed(small, ","));
+
+    std::vector<uint64_t> extremes{0, std::numeric_limits<uint64_t>::max()};
+    REQUIRE(chain::str::join(extremes, ',') == "0,18446744073709551615");
+    std::vector<int64_t> negative{std::numeric_limits<int64_t>::min()};
+    REQUIRE(chain::str::join(negative, ',') == "-9223372036854775808");
+}
+
+TEST_CASE("map_join strings")
+{
+    std::vector<int64_t> parts{1, 2, 3};
+    auto                 joined =
+        chain::str::map_join(parts, ',', [](int64_t x) { return std::string(static_cast<std::size_t>(x), 'z'); });
+    REQUIRE(joined == "z,zz,zzz");
+}
+
+TEST_CASE("join_into appends to a string")
+{
+    std::vector<int64_t> parts{1, 2, 3};
+    std::string          out{"values="};
+    chain::str::join_into(out, parts, ',');
+    REQUIRE(out == "values=1,2,3");
+
+    std::vector<std::string> words{"a", "bb"};
+    chain::str::join_into(out, words, " | ");
+    REQUIRE(out == "values=1,2,3a | bb");
+
+    out.clear();
+    const auto capacity = out.capacity();
+    chain::str::map_join_into(out, parts, ':', [](int64_t x) { return x * 10; });
+    REQUIRE(out == "10:20:30");
+    REQUIRE(out.capacity() == capacity);
+}
+
+TEST_CASE("join_into writes to a buffer")
+{
+    std::vector<std::string_view> parts{"abc", "de", "f"};
+    std::array<char, 16>          buffer{};
+
+    auto required = chain::str::join_into(buffer.data(), buffer.size(), parts, ", ");
+    REQUIRE(required == 10);
+    REQUIRE(std::string_view{buffer.data(), required} == "abc, de, f");
+
+    buffer.fill('#');
+    required = chain::str::join_into(buffer.data(), 5, parts, ',');
+    REQUIRE(required == 8);
+    REQUIRE(std::string_view{buffer.data(), 6} == "abc,d#");
+
+    std::vector<int64_t> numbers{100, -7};
+    required = chain::str::map_join_into(buffer.data(), buffer.size(), numbers, ',', [](int64_t x) { return x + 1; });
+    REQUIRE(required == 6);
+    REQUIRE(std::string_view{buffer.data(), required} == "101,-6");
+
+    REQUIRE(chain::str::join_into(nullptr, 0, parts, "") == 6);
+}
@@ -0,0 +1,134 @@
+#include "catch.hpp"
+
+#include <chain/chain.hpp>
+
+static auto same(const chain::str::multi_match& m, std::size_t pattern, std::size_t offset, std::size_t length) -> bool
+{
+    return m.pattern == pattern && m.offset == offset && m.length == length;
+}
+
+TEST_CASE("multi_searcher find_all sensitive")
+{
+    chain::str::multi_searcher s{{"he", "she", "his", "hers"}};
+    REQUIRE(s.size() == 4);
+
+    auto matches = s.find_all("ushers");
+    REQUIRE(matches.size() == 3);
+    REQUIRE(same(matches[0], 1, 1, 3)); // she
+    REQUIRE(same(matches[1], 0, 2, 2)); // he
+    REQUIRE(same(matches[2], 3, 2, 4)); // hers
+
+    REQUIRE(s.find_all("USHERS").empty());
+    REQUIRE(s.find_all("").empty());
+}
+
+TEST_CASE("multi_searcher find_all insensitive")
+{
+    using namespace chain::str;
+    multi_searcher<case_t::insensitive> s{{"GET", "post", "Put"}};
+
+    auto matches = s.find_all("get POST pUt gEtPoSt");
+    REQUIRE(matches.size() == 5);
+    REQUIRE(matches[0].pattern == 0);
+    REQUIRE(matches[1].pattern == 1);
+    REQUIRE(matches[2].pattern == 2);
+    REQUIRE(same(matches[3], 0, 13, 3));
+    REQUIRE(same(matches[4], 1, 16, 4));
+}
+
+TEST_CASE("multi_searcher overlapping and duplicate needles")
+{
+    chain::str::multi_searcher s{{"aa", "a", "", "aa"}};
+
+    auto matches = s.find_all("aaa");
+    // a@0, then aa@0 (twice) and a@1, then aa@1 (twice) and a@2
+    REQUIRE(matches.size() == 7);
+    REQUIRE(same(matches[0], 1, 0, 1));
+    REQUIRE(matches[1].offset == 0);
+    REQUIRE(matches[1].length == 2);
+    REQUIRE(matches[2].offset == 0);
+    REQUIRE(matches[2].length == 2);
+    REQUIRE(same(matches[3], 1, 1, 1));
+}
+
+TEST_CASE("multi_searcher find_for_each stop early and find_any")
+{
+    chain::str::multi_searcher s{{"b", "c"}};
+
+    uint64_t called{0};
+    s.find_for_each("abcabc", [&](const chain::str::multi_match&) -> bool {
+        ++called;
+        return called < 3;
+    });
+    REQUIRE(called == 3);
+
+    auto first = s.find_any("aaac");
+    REQUIRE(first.has_value());
+    REQUIRE(same(first.value(), 1, 3, 1));
+    REQUIRE_FALSE(s.find_any("aaaa").has_value());
+}
+
+TEST_CASE("multi_searcher matches single needle find")
+{
+    using namespace chain::str;
+    std::string haystack{};
+    for (std::size_t i = 0; i < 400; ++i)
+    {
+        haystack.push_back("abcABC"[(i * i + i / 5) % 6]);
+    }
+
+    std::vector<std::string_view>       needles{"ab", "abc", "BCA", "cab", "aBcA", "b"};
+    multi_searcher<case_t::insensitive> s{needles};
+
+    std::vector<std::size_t> counts(needles.size(), 0);
+    s.find_for_each(haystack, [&](const chain::str::multi_match& m) {
+        REQUIRE(equal<case_t::insensitive>(std::string_view{haystack}.substr(m.offset, m.length), needles[m.pattern]));
+        ++counts[m.pattern];
+    });
+
+    for (std::size_t id = 0; id < needles.size(); ++id)
+    {
+        std::size_t expected{0};
+        for (std::size_t pos = 0;
+             (pos = find<case_t::insensitive>(haystack, needles[id], pos)) != std::string_view::npos;
+             ++pos)
+        {
+            ++expected;
+        }
+        REQUIRE(counts[id] == expected);
+    }
+}
+
+TEST_CASE("multi_searcher find_leftmost_longest")
+{
+    using namespace chain::str;
+    multi_searcher s{{"he", "she", "his", "hers", "ushe"}};
+
+    std::vector<multi_match> matches{};
+    s.find_leftmost_longest("ushers hishe", [&](const multi_match& m) { matches.push_back(m); });
+    REQUIRE(matches.size() == 3);
+    REQUIRE(same(matches[0], 4, 0, 4)); // ushe, starts before she and he
+    REQUIRE(same(matches[1], 2, 7, 3)); // his
+    REQUIRE(same(matches[2], 0, 10, 2)); // he, the s was consumed by his
+
+    // A short needle inside the window of a long one that never completes is still found.
+    multi_searcher window{{"a", "b", "abcdefgh"}};
+    matches.clear();
+    window.find_leftmost_longest("abcab", [&](const multi_match& m) { matches.push_back(m); });
+    REQUIRE(matches.size() == 4);
+    REQUIRE(same(matches[0], 0, 0, 1));
+    REQUIRE(same(matches[1], 1, 1, 1));
+    REQUIRE(same(matches[2], 0, 3, 1));
+    REQUIRE(same(matches[3], 1, 4, 1));
+
+    std::size_t called{0};
+    window.find_leftmost_longest("abab", [&](const multi_match&) -> bool { return ++called < 2; });
+    REQUIRE(called == 2);
+
+    multi_searcher<case_t::insensitive> dup{{"AB", "ab", "abc"}};
+    matches.clear();
+    dup.find_leftmost_longest("xAbxABC", [&](const multi_match& m) { matches.push_back(m); });
+    REQUIRE(matches.size() == 2);
+    REQUIRE(same(matches[0], 0, 1, 2));
+    REQUIRE(same(matches[1], 2, 4, 3));
+}
@@ -0,0 +1,121 @@
+#include "catch.hpp"
+
+#include <chain/chain.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+auto split_copy(std::string_view data, char delim) -> std::vector<std::string>
+{
+    std::vector<std::string> out{};
+    for (auto part : chain::str::split(data, delim))
+    {
+        out.emplace_back(part);
+    }
+    return out;
+}
+} // namespace
+
+TEST_CASE("chain pipeline without steps")
+{
+    using namespace chain::str;
+
+    REQUIRE(chain::str::chain("herp derp").str() == "herp derp");
+    REQUIRE(chain::str::chain("").str().empty());
+    REQUIRE(chain::str::chain("a,b").split(',') == std::vector<std::string>{"a", "b"});
+    REQUIRE(chain::str::chain("").split(',') == std::vector<std::string>{""});
+}
+
+TEST_CASE("chain pipeline matches the functions applied in order")
+{
+    using namespace chain::str;
+
+    for (std::string data : {"", "   ", " \t Herp, DERP,cherp , Merp \r\n", "no-op", "  A,a,A  ", "AAAAAA"})
+    {
+        std::string expected{data};
+        trim(expected);
+        to_lower(expected);
+        replace(expected, "a", "bb");
+        replace<case_t::insensitive>(expected, "HERP", "x");
+
+        auto p = chain::str::chain(data).trim().lower().replace("a", "bb").replace<case_t::insensitive>("HERP", "x");
+        REQUIRE(p.str() == expected);
+        REQUIRE(p.split(',') == split(expected, ','));
+    }
+
+    // A temporary pipeline's parts are copies that outlive it.
+    const std::string data{" Herp,DERP,a "};
+    auto              parts = chain::str::chain(data).trim().lower().replace("a", "b").split(',');
+    REQUIRE(parts == std::vector<std::string>{"herp", "derp", "b"});
+
+    // Steps apply in order, the replacement adds whitespace that is trimmed after it.
+    REQUIRE(chain::str::chain("xherpx").replace("x", " ").trim().upper().str() == "HERP");
+    REQUIRE(chain::str::chain("xherpx").trim().replace("x", " ").upper().str() == " HERP ");
+}
+
+TEST_CASE("chain pipeline streams across case conversion blocks")
+{
+    using namespace chain::str;
+
+    // Longer than the case conversion's block so matches and parts straddle its chunks.
+    std::string data{"  "};
+    for (std::size_t i = 0; i < 3000; ++i)
+    {
+        data += "Herp,DERP ";
+    }
+    data += " \n";
+
+    std::string expected{data};
+    trim(expected);
+    to_upper(expected);
+    replace(expected, "RP,D", "-");
+
+    auto p = chain::str::chain(data).trim().upper().replace("RP,D", "-");
+    REQUIRE(p.str() == expected);
+
+    // A pipeline can be run again.
+    std::string appended{"> "};
+    p.into(appended);
+    REQUIRE(appended == "> " + expected);
+
+    std::vector<std::string> parts{};
+    p.split_for_each(',', [&](std::string_view part) { parts.emplace_back(part); });
+    REQUIRE(parts == split_copy(expected, ','));
+
+    std::size_t calls{0};
+    chain::str::chain(data).lower().split_for_each(',', [&](std::string_view part) {
+        ++calls;
+        return part != "derp herp";
+    });
+    REQUIRE(calls == 2);
+
+    // A pipeline stopped early runs in full again.
+    std::string replaced{data};
+    trim(replaced);
+    to_lower(replaced);
+    replace(replaced, "herp", "x");
+
+    auto q = chain::str::chain(data).trim().lower().replace("herp", "x");
+    calls  = 0;
+    q.split_for_each(',', [&](std::string_view) { return ++calls < 2; });
+    REQUIRE(calls == 2);
+    parts.clear();
+    q.split_for_each(',', [&](std::string_view part) {
+        parts.emplace_back(part);
+        return true;
+    });
+    REQUIRE(parts.size() == 3001);
+    REQUIRE(parts == split_copy(replaced, ','));
+
+    // The parts are views into the output the pipeline keeps.
+    auto views = q.split(',');
+    REQUIRE(views == split(replaced, ','));
+    REQUIRE(std::string_view{views.front().data(), replaced.size()} == replaced);
+
+    std::size_t size{0};
+    chain::str::chain(data).trim().lower().for_each([&](std::string_view chunk) { size += chunk.size(); });
+    REQUIRE(size == trim_view(data).size());
+}
@@ -2,6 +2,11 @@
 
 #include <chain/chain.hpp>
 
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
 TEST_CASE("replace")
 {
     std::string haystack = "derp";
@@ -86,3 +91,220 @@ TEST_CASE("replace insenstive with bigger words max coun")
     REQUIRE(haystack == "xYz|xYz|xYz|aBc|abC|AbC|aBc");
     REQUIRE(count == 3);
 }
+
+TEST_CASE("replace shrinking, equal and growing against the in place reference")
+{
+    using namespace chain::str;
+
+    // The replace-at-each-match behaviour the single pass engine must reproduce.
+    auto reference = [](std::string data, std::string_view from, std::string_view to, std::size_t max) {
+        std::size_t replaced{0};
+        std::size_t pos{0};
+        while (replaced < max && (pos = data.find(from, pos)) != std::string::npos)
+        {
+            data.replace(pos, from.length(), to.data(), to.length());
+            pos += to.length();
+            ++replaced;
+        }
+        return std::pair<std::string, std::size_t>{data, replaced};
+    };
+
+    std::string text{};
+    for (std::size_t i = 0; i < 700; ++i)
+    {
+        text.push_back("ab a"[(i * 7 + i / 3) % 4]);
+    }
+
+    for (std::string_view from : {"a", "ab", "aba", "b a", "zz"})
+    {
+        for (std::string_view to : {"", "x", "xy", "xyzw", "ab"})
+        {
+            for (std::size_t max : {std::size_t{1}, std::size_t{5}, std::numeric_limits<std::size_t>::max()})
+            {
+                auto expected = reference(text, from, to, max);
+
+                // Growing output expands in place when the capacity allows it and copies otherwise.
+                for (bool reserved : {false, true})
+                {
+                    std::string data{text};
+                    if (reserved)
+                    {
+                        data.reserve(text.size() * 4);
+                    }
+                    else
+                    {
+                        data.shrink_to_fit();
+                    }
+
+                    auto replaced = replace(data, from, to, max);
+                    REQUIRE(replaced == expected.second);
+                    REQUIRE(data == expected.first);
+                }
+
+                searcher<case_t::sensitive> precompiled{from};
+                auto [copy, replaced] = replace_copy(text, precompiled, to, max);
+                REQUIRE(replaced == expected.second);
+                REQUIRE(copy == expected.first);
+            }
+        }
+    }
+}
+
+TEST_CASE("replace empty from inserts between characters")
+{
+    std::string data = "abc";
+    REQUIRE(chain::str::replace(data, "", "-") == 4);
+    REQUIRE(data == "-a-b-c-");
+
+    std::string limited = "abc";
+    REQUIRE(chain::str::replace(limited, "", "-", 2) == 2);
+    REQUIRE(limited == "-a-bc");
+}
+
+TEST_CASE("replace_all")
+{
+    using namespace chain::str;
+
+    std::string html = "<a href=\"x\">Tom & Jerry</a>";
+    auto        count = replace_all(html, {{"&", "&amp;"}, {"<", "&lt;"}, {">", "&gt;"}, {"\"", "&quot;"}});
+    REQUIRE(count == 7);
+    REQUIRE(html == "&lt;a href=&quot;x&quot;&gt;Tom &amp; Jerry&lt;/a&gt;");
+
+    // Leftmost-longest, the substitutions are never rescanned.
+    auto [swapped, swaps] = replace_all_copy("cat dog category", {{"cat", "dog"}, {"dog", "cat"}, {"category", "X"}});
+    REQUIRE(swaps == 3);
+    REQUIRE(swapped == "dog cat X");
+
+    auto [folded, folds] = replace_all_copy<case_t::insensitive>("Hello WORLD", {{"hello", "bye"}, {"world", "all"}});
+    REQUIRE(folds == 2);
+    REQUIRE(folded == "bye all");
+
+    std::string untouched = "nothing here";
+    REQUIRE(replace_all(untouched, {{"zz", "y"}, {"", "y"}}) == 0);
+    REQUIRE(untouched == "nothing here");
+
+    multi_searcher<case_t::sensitive> needles{{"ab", "b"}};
+    std::string                       data = "abbab";
+    REQUIRE(replace_all(data, needles, {"1", "22"}) == 3);
+    REQUIRE(data == "1221");
+
+    // A substitution is required for every needle.
+    data = "abbab";
+    REQUIRE_THROWS_AS(replace_all(data, needles, {"1"}), std::invalid_argument);
+    REQUIRE_THROWS_AS(replace_all(data, needles, {}), std::invalid_argument);
+    REQUIRE_THROWS_AS(replace_all(data, needles, {"1", "22", "333"}), std::invalid_argument);
+    REQUIRE(data == "abbab");
+}
+
+TEST_CASE("replace_all matches the leftmost-longest reference")
+{
+    using namespace chain::str;
+
+    const std::vector<std::pair<std::string_view, std::string_view>> replacements{
+        {"a", "1"}, {"ab", "22"}, {"bab", ""}, {"abba", "4444"}, {"b", "b"}, {"aaaa", "x"}};
+
+    // At each offset take the longest `from` that matches, the first pair wins ties.
+    auto reference = [&](std::string_view data) {
+        std::string out{};
+        std::size_t replaced{0};
+        std::size_t i{0};
+        while (i < data.size())
+        {
+            std::optional<std::size_t> best{};
+            for (std::size_t r = 0; r < replacements.size(); ++r)
+            {
+                const auto from = replacements[r].first;
+                if (data.substr(i, from.size()) == from && (!best || from.size() > replacements[*best].first.size()))
+                {
+                    best = r;
+                }
+            }
+            if (best)
+            {
+                out.append(replacements[*best].second);
+                i += replacements[*best].first.size();
+                ++replaced;
+            }
+            else
+            {
+                out.push_back(data[i++]);
+            }
+        }
+        return std::pair<std::string, std::size_t>{out, replaced};
+    };
+
+    std::string text{};
+    for (std::size_t i = 0; i < 2000; ++i)
+    {
+        text.push_back("aab.b"[(i * i + i / 5) % 5]);
+        auto view     = std::string_view{text}.substr(i / 2);
+        auto expected = reference(view);
+        REQUIRE(replace_all_copy(std::string{view}, replacements) == expected);
+    }
+}
+
+TEST_CASE("stream_replacer matches replace for every chunk size")
+{
+    using namespace chain::str;
+
+    std::string text{};
+    for (std::size_t i = 0; i < 500; ++i)
+    {
+        text.push_back("abcAB"[(i * 3 + i / 4) % 5]);
+    }
+
+    for (std::string_view from : {"a", "ab", "abca", "bcab", "zzz"})
+    {
+        auto expected = replace_copy(text, from, "<>");
+        auto folded   = replace_copy<case_t::insensitive>(text, from, "");
+
+        for (std::size_t chunk : {1, 2, 3, 5, 64, 1000})
+        {
+            stream_replacer replacer{from, "<>"};
+            std::string     out{};
+            auto            sink = [&out](std::string_view part) { out.append(part); };
+            for (std::size_t pos = 0; pos < text.size(); pos += chunk)
+            {
+                replacer.write(std::string_view{text}.substr(pos, chunk), sink);
+            }
+            replacer.finish(sink);
+
+            REQUIRE(out == expected.first);
+            REQUIRE(replacer.replaced() == expected.second);
+
+            stream_replacer<case_t::insensitive> insensitive{from, ""};
+            std::string                          folded_out{};
+            for (std::size_t pos = 0; pos < text.size(); pos += chunk)
+            {
+                insensitive.write(
+                    std::string_view{text}.substr(pos, chunk), [&](std::string_view part) { folded_out.append(part); });
+            }
+            insensitive.finish([&](std::string_view part) { folded_out.append(part); });
+
+            REQUIRE(folded_out == folded.first);
+            REQUIRE(insensitive.replaced() == folded.second);
+        }
+    }
+}
+
+TEST_CASE("stream_replacer holds back at most from.size() - 1 bytes")
+{
+    chain::str::stream_replacer replacer{"derp", "x"};
+    std::string                 out{};
+    auto                        sink = [&out](std::string_view part) { out.append(part); };
+
+    replacer.write("hello de", sink);
+    REQUIRE(out == "hello");
+    replacer.write("r", sink);
+    REQUIRE(out == "hello ");
+    replacer.write("p and der", sink);
+    REQUIRE(out == "hello x and ");
+    replacer.finish(sink);
+    REQUIRE(out == "hello x and der");
+    REQUIRE(replacer.replaced() == 1);
+
+    chain::str::stream_replacer passthrough{"", "x"};
+    std::string                 same{};
+    passthrough.write("abc", [&same](std::string_view part) { same.append(part); });
+    REQUIRE(same == "abc");
+}
@@ -0,0 +1,128 @@
+#include "catch.hpp"
+
+#include <chain/chain.hpp>
+
+TEST_CASE("searcher find sensitive")
+{
+    using namespace chain::str;
+    searcher s{"derp"};
+    REQUIRE(s.size() == 4);
+    REQUIRE(s.find("asdfjsldkfjslkdjfderpldkjfl") == 17);
+    REQUIRE(s.find("asdfjsldkfjslkdjfpderldkjfl") == std::string_view::npos);
+    REQUIRE(s.find("asdfjsldkfjslkdjfDERPldkjfl") == std::string_view::npos);
+    REQUIRE(s.find("derpaaaaaaaaaaaaaaaaaderp") == 0);
+    REQUIRE(s.find("derpaaaaaaaaaaaaaaaaaderp", 1) == 21);
+    REQUIRE(s.find("derpaaaaaaaaaaaaaaaaaderp", 22) == std::string_view::npos);
+    REQUIRE(s.find("der") == std::string_view::npos);
+    REQUIRE(s.find("") == std::string_view::npos);
+}
+
+TEST_CASE("searcher find insensitive")
+{
+    using namespace chain::str;
+    searcher<case_t::insensitive> s{"DeRp"};
+    REQUIRE(s.needle() == "derp");
+    REQUIRE(s.find("asdfjsldkfjslkdjfDERPldkjfl") == 17);
+    REQUIRE(s.find("asdfjsldkfjslkdjfpDeRldkjfl") == std::string_view::npos);
+    REQUIRE(s.find("dERPaaaaaaaaaaaaaaaaaaaaa") == 0);
+    REQUIRE(s.find("derpaaaaaaaaaaaaaaaaadErP", 1) == 21);
+}
+
+TEST_CASE("searcher rfind matches free rfind")
+{
+    using namespace chain::str;
+    std::string_view haystack = "derpaaaaaaaaaaaaaaaaaderp";
+    searcher                      sensitive{"derp"};
+    searcher<case_t::insensitive> insensitive{"DERP"};
+
+    for (std::size_t pos :
+         {std::size_t{0}, std::size_t{3}, std::size_t{20}, std::size_t{21}, std::size_t{22}, std::string_view::npos})
+    {
+        REQUIRE(sensitive.rfind(haystack, pos) == rfind(haystack, "derp", pos));
+        REQUIRE(insensitive.rfind(haystack, pos) == rfind<case_t::insensitive>(haystack, "DERP", pos));
+    }
+
+    REQUIRE(sensitive.rfind("abcdefghijklmnopabc") == std::string_view::npos);
+    REQUIRE(searcher{"abc"}.rfind("abcdefghijklmnopabc") == 16);
+    REQUIRE(searcher{"bcd"}.rfind("abcdefghijklmnopdcb", 18) == 1);
+}
+
+TEST_CASE("searcher find matches free find")
+{
+    using namespace chain::str;
+    std::string haystack{};
+    for (std::size_t i = 0; i < 500; ++i)
+    {
+        haystack.push_back("abcABC"[(i * i + i / 7) % 6]);
+    }
+
+    for (std::string_view needle : {"a", "ab", "abc", "bCa", "cabca", "aaaa", "AbCaBcAbC"})
+    {
+        searcher                      sensitive{needle};
+        searcher<case_t::insensitive> insensitive{needle};
+        for (std::size_t pos = 0; pos < haystack.size(); pos += 17)
+        {
+            REQUIRE(sensitive.find(haystack, pos) == find(haystack, needle, pos));
+            REQUIRE(insensitive.find(haystack, pos) == find<case_t::insensitive>(haystack, needle, pos));
+            REQUIRE(sensitive.rfind(haystack, pos) == rfind(haystack, needle, pos));
+            REQUIRE(insensitive.rfind(haystack, pos) == rfind<case_t::insensitive>(haystack, needle, pos));
+        }
+    }
+}
+
+TEST_CASE("searcher find_all")
+{
+    using namespace chain::str;
+    searcher s{"aa"};
+    auto     offsets = s.find_all("aaaaa baa");
+    REQUIRE(offsets == std::vector<std::size_t>{0, 2, 7});
+    REQUIRE(searcher{""}.find_all("abc").empty());
+}
+
+TEST_CASE("split with searcher")
+{
+    using namespace chain::str;
+    searcher<case_t::insensitive> delim{"XyZ"};
+    auto                          parts = split("1xyz2XYZ3", delim);
+
+    REQUIRE(parts.size() == 3);
+    REQUIRE(parts[0] == "1");
+    REQUIRE(parts[1] == "2");
+    REQUIRE(parts[2] == "3");
+}
+
+TEST_CASE("split_for_each with searcher stop early")
+{
+    using namespace chain::str;
+    searcher delim{","};
+    uint64_t called{0};
+    split_for_each("1,2,3,4,5", delim, [&](std::string_view) -> bool {
+        ++called;
+        return called < 2;
+    });
+
+    REQUIRE(called == 2);
+}
+
+TEST_CASE("replace with searcher")
+{
+    using namespace chain::str;
+    searcher<case_t::insensitive> from{"AbC"};
+    std::string                   haystack = "abc|ABC|Abc|aBc";
+
+    REQUIRE(replace(haystack, from, "xYz", 3) == 3);
+    REQUIRE(haystack == "xYz|xYz|xYz|aBc");
+
+    auto [data, count] = replace_copy(std::string{"abcabc"}, from, "z");
+    REQUIRE(data == "zz");
+    REQUIRE(count == 2);
+}
+
+TEST_CASE("searcher count and overlapping find_all")
+{
+    using namespace chain::str;
+    searcher<case_t::insensitive> s{"AA"};
+    REQUIRE(s.count("aaAa") == 2);
+    REQUIRE(s.count<overlap_t::overlapping>("aaAa") == 3);
+    REQUIRE(s.find_all<overlap_t::overlapping>("aaAa") == std::vector<std::size_t>{0, 1, 2});
+}
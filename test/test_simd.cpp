@@ -0,0 +1,99 @@
+#include "catch.hpp"
+
+#include <chain/chain.hpp>
+
+#include <cctype>
+
+using chain::str::simd_level;
+
+static const std::vector<simd_level> g_levels{
+    simd_level::scalar, simd_level::sse2, simd_level::sse42, simd_level::avx2, simd_level::avx512};
+
+TEST_CASE("simd_level names")
+{
+    using namespace chain::str;
+    for (auto level : g_levels)
+    {
+        REQUIRE(simd_level_from_string(to_string(level)) == level);
+    }
+    REQUIRE(simd_level_from_string("AVX2") == simd_level::avx2);
+    REQUIRE_FALSE(simd_level_from_string("avx3").has_value());
+}
+
+TEST_CASE("force_simd_level is capped at the detected level")
+{
+    using namespace chain::str;
+    const auto original = active_simd_level();
+
+    REQUIRE(force_simd_level(simd_level::scalar) == simd_level::scalar);
+    REQUIRE(active_simd_level() == simd_level::scalar);
+    REQUIRE(force_simd_level(simd_level::avx512) == detected_simd_level());
+
+    force_simd_level(original);
+}
+
+TEST_CASE("every simd_level agrees with the scalar reference")
+{
+    using namespace chain::str;
+    const auto original = active_simd_level();
+
+    // Covers every byte value and enough length for full vectors plus tails at each width.
+    std::string data{};
+    for (std::size_t i = 0; i < 777; ++i)
+    {
+        data.push_back(static_cast<char>((i * 37 + i / 11) % 256));
+    }
+    std::string padded = "  \t\n\v\f\r" + std::string(150, ' ') + data + std::string(130, '\t') + " \r\n";
+
+    for (auto level : g_levels)
+    {
+        if (level > detected_simd_level())
+        {
+            continue;
+        }
+        INFO("simd_level " << to_string(level));
+        REQUIRE(force_simd_level(level) == level);
+
+        std::string lower = data;
+        std::string upper = data;
+        to_lower(lower);
+        to_upper(upper);
+        for (std::size_t i = 0; i < data.size(); ++i)
+        {
+            auto c = static_cast<unsigned char>(data[i]);
+            REQUIRE(lower[i] == static_cast<char>((c >= 'A' && c <= 'Z') ? c + 32 : c));
+            REQUIRE(upper[i] == static_cast<char>((c >= 'a' && c <= 'z') ? c - 32 : c));
+        }
+
+        REQUIRE(equal<case_t::insensitive>(lower, upper));
+        for (std::size_t i = 0; i < data.size(); i += 13)
+        {
+            std::string changed = upper;
+            changed[i] ^= 0x01;
+            REQUIRE(equal<case_t::insensitive>(lower, changed) == (std::tolower(lower[i]) == std::tolower(changed[i])));
+        }
+
+        REQUIRE(trim_view(padded) == data);
+        REQUIRE(trim_left_view(padded).size() == padded.size() - 157);
+        REQUIRE(trim_right_view(padded).size() == padded.size() - 133);
+        REQUIRE(trim_view(std::string(200, ' ')).empty());
+        std::string trimmed = padded;
+        trim(trimmed);
+        REQUIRE(trimmed == data);
+
+        for (std::size_t start = 0; start + 70 < upper.size(); start += 61)
+        {
+            for (std::size_t length : {1, 2, 3, 9, 70})
+            {
+                auto needle = std::string_view{upper}.substr(start, length);
+                REQUIRE(find<case_t::insensitive>(lower, needle) <= start);
+                REQUIRE(equal<case_t::insensitive>(
+                    std::string_view{lower}.substr(find<case_t::insensitive>(lower, needle), length), needle));
+                REQUIRE(rfind<case_t::insensitive>(lower, needle) >= start);
+                REQUIRE(rfind<case_t::insensitive>(lower, needle, start + length) == start);
+            }
+        }
+    }
+
+    force_simd_level(original);
+}
@@ -175,3 +175,182 @@ TEST_CASE("split_for_each stop early")
 
     REQUIRE(called == 3);
 }
+
+TEST_CASE("split_view range for")
+{
+    std::vector<std::string_view> parts{};
+    for (auto part : chain::str::split_view{"1,22,,333", ','})
+    {
+        parts.push_back(part);
+    }
+
+    REQUIRE(parts == chain::str::split("1,22,,333", ','));
+}
+
+TEST_CASE("split_view matches split")
+{
+    using namespace chain::str;
+    for (std::string_view data : {"", ",", "herpderp", ",herpderp", "herpderp,", ",herp,derp,", ",,,"})
+    {
+        split_view view{data, ','};
+        REQUIRE(std::vector<std::string_view>(view.begin(), view.end()) == split(data, ','));
+        REQUIRE(static_cast<std::size_t>(std::distance(view.begin(), view.end())) == split(data, ',').size());
+    }
+
+    split_view<case_t::insensitive> view{"xyzherpXYZderpxYz", "XyZ"};
+    REQUIRE(
+        std::vector<std::string_view>(view.begin(), view.end()) ==
+        split<case_t::insensitive>("xyzherpXYZderpxYz", "XyZ"));
+}
+
+TEST_CASE("split_view stop early and algorithms")
+{
+    using namespace chain::str;
+    split_view view{"1:-2:-3:-4", ":-"};
+
+    auto found = std::find(view.begin(), view.end(), "3");
+    REQUIRE(found != view.end());
+    REQUIRE(*found == "3");
+    REQUIRE(found->size() == 1);
+    REQUIRE(*(++found) == "4");
+    REQUIRE(++found == view.end());
+
+    uint64_t called{0};
+    for (auto part : view)
+    {
+        ++called;
+        if (part == "2")
+        {
+            break;
+        }
+    }
+    REQUIRE(called == 2);
+
+    // Copies of a char delimited view stay valid after the original is gone.
+    auto copy = [] { return split_view{"a|b", '|'}; }();
+    REQUIRE(std::distance(copy.begin(), copy.end()) == 2);
+
+    split_view empty_delim{"abc", ""};
+    REQUIRE(*empty_delim.begin() == "abc");
+    REQUIRE(std::distance(empty_delim.begin(), empty_delim.end()) == 1);
+}
+
+TEST_CASE("split char matches split string view at every simd_level")
+{
+    using namespace chain::str;
+    const auto original = active_simd_level();
+
+    // Spans several 1 KiB blocks with a partial final block and runs of empty parts.
+    std::string data{};
+    for (std::size_t i = 0; i < 2500; ++i)
+    {
+        data.push_back("ab,\tX,x"[(i * i + i / 7) % 7]);
+    }
+
+    for (auto level : {simd_level::scalar, simd_level::sse2, simd_level::avx2, simd_level::avx512})
+    {
+        force_simd_level(level);
+
+        for (char delim : {',', '\t', 'x', '#'})
+        {
+            const std::string_view delim_view{&delim, 1};
+            REQUIRE(split(data, delim) == split(data, delim_view));
+            REQUIRE(split<case_t::insensitive>(data, delim) == split<case_t::insensitive>(data, delim_view));
+
+            auto sizes = split_map<std::size_t>(data, delim, [](std::string_view part) { return part.size(); });
+            REQUIRE(sizes.size() == split(data, delim_view).size());
+
+            std::size_t called{0};
+            split_for_each(data, delim, [&](std::string_view) -> bool {
+                ++called;
+                return called < 5;
+            });
+            REQUIRE(called == std::min<std::size_t>(5, sizes.size()));
+        }
+    }
+
+    force_simd_level(original);
+}
+
+TEST_CASE("split_as typed fields")
+{
+    using namespace chain::str;
+
+    auto record = split_as<int64_t, std::string_view, double>("42,widget,9.5", ',');
+    REQUIRE(record.has_value());
+    REQUIRE(std::get<0>(record.value()) == 42);
+    REQUIRE(std::get<1>(record.value()) == "widget");
+    REQUIRE(std::get<2>(record.value()) == 9.5);
+
+    auto text = split_as<std::string, uint16_t>("port :: 8080", " :: ");
+    REQUIRE(text.has_value());
+    REQUIRE(std::get<0>(text.value()) == "port");
+    REQUIRE(std::get<1>(text.value()) == 8080);
+
+    searcher<case_t::insensitive> and_delim{" AND "};
+    auto                          keyed = split_as<std::string_view, int>("a and 7", and_delim);
+    REQUIRE(keyed.has_value());
+    REQUIRE(std::get<0>(keyed.value()) == "a");
+    REQUIRE(std::get<1>(keyed.value()) == 7);
+}
+
+TEST_CASE("split_as rejects mismatched records")
+{
+    using namespace chain::str;
+
+    REQUIRE_FALSE(split_as<int, int>("1,2,3", ',').has_value());
+    REQUIRE_FALSE(split_as<int, int, int>("1,2", ',').has_value());
+    REQUIRE_FALSE(split_as<int, int>("1,x", ',').has_value());
+    REQUIRE_FALSE(split_as<uint32_t, int>("-1,2", ',').has_value());
+    REQUIRE_FALSE(split_as<int, std::string_view>(",a", ',').has_value());
+    REQUIRE(split_as<std::string_view, std::string_view>(",", ',').has_value());
+}
+
+TEST_CASE("split_into writes fields")
+{
+    using namespace chain::str;
+
+    struct record
+    {
+        int              id{0};
+        std::string_view name{};
+        float            price{0};
+    };
+
+    record r{};
+    REQUIRE(split_into("7|bolt|0.25", '|', r.id, r.name, r.price));
+    REQUIRE(r.id == 7);
+    REQUIRE(r.name == "bolt");
+    REQUIRE(r.price == 0.25f);
+
+    record partial{};
+    REQUIRE_FALSE(split_into("8|nut|cheap", '|', partial.id, partial.name, partial.price));
+    REQUIRE(partial.id == 8);
+    REQUIRE(partial.name == "nut");
+    REQUIRE(partial.price == 0);
+}
+
+TEST_CASE("split into a fixed number of parts at compile time")
+{
+    using namespace chain::str;
+
+    constexpr auto request = split<3>("GET /index.html HTTP/1.1", ' ');
+    static_assert(request[0] == "GET");
+    static_assert(request[1] == "/index.html");
+    static_assert(request[2] == "HTTP/1.1");
+
+    // The rest of the data is in the last part, missing parts are empty.
+    constexpr auto header = split<2>("Host: localhost: 8080", ": ");
+    static_assert(header[0] == "Host");
+    static_assert(header[1] == "localhost: 8080");
+    static_assert(split<3>("a,b", ',')[2].empty());
+    static_assert(split<1>("a,b", ',')[0] == "a,b");
+    static_assert(split<2>("a,b", "")[0] == "a,b");
+    static_assert(split<2, case_t::insensitive>("keyXvalue", "x")[1] == "value");
+
+    const std::string runtime{"1,2,3,4"};
+    const auto        parts = split<3>(runtime, ',');
+    REQUIRE(parts[0] == "1");
+    REQUIRE(parts[1] == "2");
+    REQUIRE(parts[2] == "3,4");
+}
@@ -2,6 +2,13 @@
 
 #include <chain/chain.hpp>
 
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
 TEST_CASE("strerror(errsv) -> std::string")
 {
     {
@@ -11,3 +18,54 @@ TEST_CASE("strerror(errsv) -> std::string")
         REQUIRE(error.length() == expected.length());
     }
 }
+
+TEST_CASE("strerror_view(errsv) -> std::string_view")
+{
+    using namespace chain::str;
+
+    REQUIRE(strerror_view(EAGAIN) == "Resource temporarily unavailable");
+    REQUIRE(strerror_view(EAGAIN).data() == strerror_view(EAGAIN).data());
+    REQUIRE(strerror_view(0) == chain::str::strerror(0));
+
+    for (int errsv : {-1, 1, ENOENT, EINTR, 133, 255, 256, 4096})
+    {
+        std::string expected = std::strerror(errsv);
+        REQUIRE(strerror_view(errsv) == expected);
+        REQUIRE(chain::str::strerror(errsv) == expected);
+    }
+
+    // Views of values outside the table stay valid after later calls.
+    const auto first  = strerror_view(1000);
+    const auto second = strerror_view(1001);
+    REQUIRE(first == std::string{std::strerror(1000)});
+    REQUIRE(second == std::string{std::strerror(1001)});
+    REQUIRE(first != second);
+    REQUIRE(strerror_view(1000).data() == first.data());
+
+    // std::strerror isn't thread safe, the expected strings are made before the threads start.
+    std::vector<std::string> expected{};
+    for (int errsv = 0; errsv < 300; ++errsv)
+    {
+        expected.emplace_back(std::strerror(errsv));
+    }
+
+    std::vector<std::thread> threads{};
+    std::atomic<bool>        matched{true};
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&]() {
+            for (int errsv = 0; errsv < 300; ++errsv)
+            {
+                if (strerror_view(errsv) != expected[static_cast<std::size_t>(errsv)])
+                {
+                    matched = false;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(matched);
+}
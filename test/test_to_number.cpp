@@ -2,6 +2,14 @@
 
 #include <chain/chain.hpp>
 
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
 TEST_CASE("integer")
 {
     auto value = chain::str::to_number<int>("1");
@@ -126,3 +134,246 @@ TEST_CASE("is_number")
     REQUIRE(chain::str::is_number("1234567890"));
     REQUIRE(chain::str::is_number("1.4"));
 }
+
+TEST_CASE("classify_number")
+{
+    using namespace chain::str;
+
+    auto check = [](std::string_view data, number_class kind, std::size_t length) {
+        const auto result = classify_number(data);
+        REQUIRE(result.kind == kind);
+        REQUIRE(result.length == length);
+    };
+
+    check("42", number_class::integer, 2);
+    check("-42", number_class::integer, 3);
+    check("+42abc", number_class::integer, 3);
+    check("1e", number_class::integer, 1);
+    check("1e+", number_class::integer, 1);
+    check("4.2", number_class::floating, 3);
+    check("4.", number_class::floating, 2);
+    check(".5", number_class::floating, 2);
+    check("-.5.5", number_class::floating, 3);
+    check("0x2A", number_class::hex, 4);
+    check("-0Xffz", number_class::hex, 5);
+    check("0x", number_class::integer, 1);
+    check("0xg", number_class::integer, 1);
+    check("4.2e-1", number_class::exponent, 6);
+    check("4E10x", number_class::exponent, 4);
+    check(".5e+3", number_class::exponent, 5);
+    check("0x1.8", number_class::floating, 5);
+    check("-0x.8p-1", number_class::exponent, 8);
+    check("0x1e5", number_class::hex, 5);
+
+    // Leading whitespace, infinity and NaN are classified the same as to_number parses them for
+    // floating point types.
+    check(" 5", number_class::integer, 2);
+    check(" \t-1.5", number_class::floating, 6);
+    check("inf", number_class::floating, 3);
+    check("-Infinity", number_class::floating, 9);
+    check("infinit", number_class::floating, 3);
+    check("NaN", number_class::floating, 3);
+    check("nan(0x1_f)z", number_class::floating, 10);
+    check("nan(", number_class::floating, 3);
+
+    check("", number_class::invalid, 0);
+    check("-", number_class::invalid, 0);
+    check(".", number_class::invalid, 0);
+    check("+-5", number_class::invalid, 0);
+    check("e5", number_class::invalid, 0);
+    check("0x.", number_class::invalid, 0);
+    check("in", number_class::invalid, 0);
+
+    REQUIRE(is_int("12abc"));
+    REQUIRE_FALSE(is_int("1e5"));
+    REQUIRE(is_float("1e5"));
+    REQUIRE(is_float("-.5"));
+    REQUIRE_FALSE(is_float("0x2A"));
+    REQUIRE(is_number("0x2A"));
+    REQUIRE_FALSE(is_number("abc"));
+    REQUIRE_FALSE(is_number("."));
+}
+
+TEST_CASE("is_int, is_float and is_number agree with to_number")
+{
+    using namespace chain::str;
+
+    REQUIRE(is_float(" 1.5"));
+    REQUIRE(is_number(" 1.5"));
+    REQUIRE(to_number<double>(" 1.5").value() == 1.5);
+
+    REQUIRE(is_float("inf"));
+    REQUIRE(is_float("-INF"));
+    REQUIRE(is_number("infinity"));
+    REQUIRE(to_number<double>("-INF").value() == -std::numeric_limits<double>::infinity());
+    REQUIRE(is_float("nan"));
+    REQUIRE(is_number("NaN"));
+    REQUIRE(std::isnan(to_number<double>("NaN").value()));
+
+    // to_number parses hexadecimal only for floating point types.
+    REQUIRE_FALSE(is_int("0x2A"));
+    REQUIRE(to_number<int64_t>("0x2A").value() == 0);
+    REQUIRE(is_number("0x2A"));
+    REQUIRE(to_number<double>("0x2A").value() == 42.0);
+    REQUIRE(is_float("0x1.8p1"));
+    REQUIRE(to_number<double>("0x1.8p1").value() == 3.0);
+
+    // to_number doesn't skip leading whitespace for integer types.
+    REQUIRE_FALSE(is_int(" 5"));
+    REQUIRE_FALSE(to_number<int64_t>(" 5").has_value());
+    REQUIRE(is_number(" 5"));
+    REQUIRE(to_number<double>(" 5").value() == 5.0);
+}
+
+TEST_CASE("float accepts what std::stod accepts")
+{
+    using chain::str::to_number;
+
+    REQUIRE(to_number<double>("  \t2.5").value() == 2.5);
+    REQUIRE(to_number<double>("+1.5").value() == 1.5);
+    REQUIRE(to_number<double>("-1.5e3").value() == -1500.0);
+    REQUIRE(to_number<double>("1.5abc").value() == 1.5);
+    REQUIRE(to_number<double>(".25").value() == 0.25);
+    REQUIRE(to_number<double>("0x1p4").value() == 16.0);
+    REQUIRE(to_number<double>("-0X1A").value() == -26.0);
+    REQUIRE(to_number<double>("0x").value() == 0.0);
+    REQUIRE(to_number<double>("inf").value() == std::numeric_limits<double>::infinity());
+    REQUIRE(std::isnan(to_number<double>("nan").value()));
+
+    REQUIRE_FALSE(to_number<double>("").has_value());
+    REQUIRE_FALSE(to_number<double>("-").has_value());
+    REQUIRE_FALSE(to_number<double>("+-1").has_value());
+    REQUIRE_FALSE(to_number<double>("--1").has_value());
+    REQUIRE_FALSE(to_number<double>("1e400").has_value());
+    REQUIRE_FALSE(to_number<float>("1e39").has_value());
+}
+
+TEST_CASE("float rounds like strtod")
+{
+    using chain::str::to_number;
+
+    uint64_t bits{0x9E3779B97F4A7C15ULL};
+    for (std::size_t i = 0; i < 2000; ++i)
+    {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+
+        double original{};
+        std::memcpy(&original, &bits, sizeof(original));
+        if (!std::isfinite(original))
+        {
+            continue;
+        }
+
+        // 17 significant digits round trip a double, fewer digits exercise rounding.
+        for (int precision : {6, 17, 25})
+        {
+            char text[64];
+            std::snprintf(text, sizeof(text), "%.*g", precision, original);
+
+            const double expected = std::strtod(text, nullptr);
+            if (std::isinf(expected) || std::fpclassify(expected) == FP_SUBNORMAL)
+            {
+                continue;
+            }
+            REQUIRE(to_number<double>(std::string_view{text}).value() == expected);
+
+            const float expected_float = std::strtof(text, nullptr);
+            if (std::isfinite(expected_float) && std::fpclassify(expected_float) == FP_NORMAL)
+            {
+                REQUIRE(to_number<float>(std::string_view{text}).value() == expected_float);
+            }
+        }
+    }
+
+    REQUIRE(to_number<long double>("1e4000").has_value());
+    REQUIRE(to_number<long double>("0.1").value() == 0.1L);
+}
+
+TEST_CASE("integer decimal digits up to 20")
+{
+    using namespace chain::str;
+
+    std::string digits{};
+    uint64_t    expected{0};
+    for (std::size_t n = 1; n <= 19; ++n)
+    {
+        digits.push_back(static_cast<char>('0' + (n * 7) % 10));
+        expected = expected * 10 + (n * 7) % 10;
+
+        REQUIRE(to_number<uint64_t>(digits).value() == expected);
+        REQUIRE(to_number<uint64_t>(digits + "x9").value() == expected);
+        REQUIRE(to_number<int64_t>("-" + digits).value() == -static_cast<int64_t>(expected));
+        REQUIRE(to_number<int64_t>("+" + digits).value() == static_cast<int64_t>(expected));
+    }
+
+    REQUIRE(to_number<int64_t>("9223372036854775807").value() == std::numeric_limits<int64_t>::max());
+    REQUIRE(to_number<int64_t>("-9223372036854775808").value() == std::numeric_limits<int64_t>::min());
+    REQUIRE(to_number<uint64_t>("18446744073709551615").value() == std::numeric_limits<uint64_t>::max());
+    REQUIRE(to_number<uint64_t>("00000000000000000000000042").value() == 42);
+    REQUIRE(to_number<int8_t>("-128").value() == -128);
+    REQUIRE(to_number<uint16_t>("65535").value() == 65535);
+
+    REQUIRE(to_number<int>("+-5").value() == -5);
+    REQUIRE(to_number<int>("12abc").value() == 12);
+    REQUIRE_FALSE(to_number<int>("--5").has_value());
+    REQUIRE_FALSE(to_number<unsigned>("+-5").has_value());
+    REQUIRE_FALSE(to_number<unsigned>("-5").has_value());
+    REQUIRE_FALSE(to_number<int>("-").has_value());
+    REQUIRE_FALSE(to_number<int>("").has_value());
+}
+
+TEST_CASE("to_numbers matches to_number at every simd_level")
+{
+    using namespace chain::str;
+    const auto original = active_simd_level();
+
+    std::vector<std::string> fields{
+        "", "+", "-", "0", "7", "-7", "+7", "+-7", "--7", "12abc", "1234567", "12345678", "123456789",
+        "1234567890123456", "12345678901234567", "123456789012345678", "1234567890123456789",
+        "9223372036854775807", "-9223372036854775808", "9223372036854775808", "18446744073709551615",
+        "18446744073709551616", "99999999999999999999999", "1234567890123456x", "123456789012345x7",
+        "0000000000000000000012", "-00000000000000001"};
+
+    // More than one block of 64 fields.
+    uint64_t bits{0x9E3779B97F4A7C15ULL};
+    for (std::size_t i = 0; i < 150; ++i)
+    {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        fields.push_back(std::to_string(bits >> (i % 64)).substr(0, 1 + i % 21));
+    }
+
+    for (auto level : {simd_level::scalar, simd_level::sse2, simd_level::sse42, simd_level::avx2, simd_level::avx512})
+    {
+        force_simd_level(level);
+
+        auto signed_values   = to_numbers<int64_t>(fields);
+        auto unsigned_values = to_numbers<uint64_t>(fields);
+        auto small_values    = to_numbers<int16_t>(fields);
+        REQUIRE(signed_values.size() == fields.size());
+
+        for (std::size_t i = 0; i < fields.size(); ++i)
+        {
+            REQUIRE(signed_values[i] == to_number<int64_t>(fields[i]));
+            REQUIRE(unsigned_values[i] == to_number<uint64_t>(fields[i]));
+            REQUIRE(small_values[i] == to_number<int16_t>(fields[i]));
+
+            uint64_t   reference{};
+            const auto first  = fields[i].data() + ((!fields[i].empty() && fields[i].front() == '+') ? 1 : 0);
+            const auto result = std::from_chars(first, fields[i].data() + fields[i].size(), reference);
+            if (result.ec == std::errc{})
+            {
+                REQUIRE(unsigned_values[i].value() == reference);
+            }
+        }
+    }
+
+    std::vector<std::optional<double>> doubles{};
+    REQUIRE(to_numbers<double>(std::vector<std::string_view>{"1.5", "x", "-2"}, doubles) == 2);
+    REQUIRE(doubles == std::vector<std::optional<double>>{1.5, std::nullopt, -2.0});
+
+    force_simd_level(original);
+}
@@ -25,3 +25,55 @@ TEST_CASE("to_upper_copy")
 {
     REQUIRE(chain::str::to_upper_copy("derp") == "DERP");
 }
+
+TEST_CASE("to_lower_ascii and to_upper_ascii every byte at every simd_level")
+{
+    using namespace chain::str;
+
+    std::string data{};
+    for (std::size_t i = 0; i < 3 * 256 + 13; ++i)
+    {
+        data.push_back(static_cast<char>(i * 7));
+    }
+
+    std::string lower_expected{data};
+    std::string upper_expected{data};
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        const auto c = static_cast<unsigned char>(data[i]);
+        if (c >= 'A' && c <= 'Z')
+        {
+            lower_expected[i] = static_cast<char>(c + 32);
+        }
+        if (c >= 'a' && c <= 'z')
+        {
+            upper_expected[i] = static_cast<char>(c - 32);
+        }
+    }
+
+    const auto original = active_simd_level();
+    for (auto level : {simd_level::scalar, simd_level::sse2, simd_level::avx2, simd_level::avx512})
+    {
+        force_simd_level(level);
+
+        // Every length up to a few vectors so the SWAR and vector tails are covered.
+        for (std::size_t size = 0; size < 200; ++size)
+        {
+            const std::string_view view{data.data() + 3, size};
+            std::string            out(size, '#');
+
+            to_lower_ascii(view, out.data());
+            REQUIRE(out == std::string_view{lower_expected.data() + 3, size});
+            to_upper_ascii(view, out.data());
+            REQUIRE(out == std::string_view{upper_expected.data() + 3, size});
+        }
+
+        REQUIRE(to_lower_copy(data) == lower_expected);
+        REQUIRE(to_upper_copy(data) == upper_expected);
+
+        std::string in_place{data};
+        to_lower_ascii(in_place, in_place.data());
+        REQUIRE(in_place == lower_expected);
+    }
+    force_simd_level(original);
+}
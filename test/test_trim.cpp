@@ -458,3 +458,17 @@ TEST_CASE("trim_view with to remove multiple")
     REQUIRE(chain::str::trim_view("abcdefefgabcdef", {"abc", "def"}) == "efg");
     REQUIRE(chain::str::trim_view("efgdefabc", {"abc", "efg"}) == "def");
 }
+
+TEST_CASE("trim_view at compile time")
+{
+    using namespace chain::str;
+
+    static_assert(trim_view(" \t herp \r\n") == "herp");
+    static_assert(trim_left_view("  herp  ") == "herp  ");
+    static_assert(trim_right_view("  herp  ") == "  herp");
+    static_assert(trim_view("   ").empty());
+    static_assert(trim_view("xXherpxX", "x") == "XherpxX");
+    static_assert(trim_view<case_t::insensitive>("xXherpxX", "x") == "herp");
+    static_assert(trim_left_view<case_t::insensitive>("abABherp", "ab") == "herp");
+    static_assert(trim_right_view<case_t::insensitive>("herpabAB", "ab") == "herp");
+}